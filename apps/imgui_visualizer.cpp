@@ -2,10 +2,12 @@
 #include <cstdint>
 #include <filesystem>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 #include "ultrasound/config.hpp"
 #include "ultrasound/config_io.hpp"
+#include "ultrasound/geometry_plan.hpp"
 #include "ultrasound/processor.hpp"
 #include "ultrasound/replay.hpp"
 #include "ultrasound/visualizer.hpp"
@@ -27,7 +29,28 @@ int main(int argc, char** argv) {
         config.processing_method = ultrasound::ProcessingMethod::All;
     }
 
-    ultrasound::UltrasoundProcessor processor(config);
+    ultrasound::VisualizerSettings settings;
+    namespace fs = std::filesystem;
+    fs::path vehicle_cfg_path;
+    bool geometry_loaded = false;
+    if (argc >= 4) {
+        vehicle_cfg_path = fs::path(argv[3]);
+    } else {
+        vehicle_cfg_path = fs::path("configs") / "vehicle_profile_reference.ini";
+    }
+    if (fs::exists(vehicle_cfg_path)) {
+        const auto geometry_status = ultrasound::load_vehicle_geometry_from_ini(vehicle_cfg_path.string(), settings.vehicle_geometry);
+        if (!geometry_status.is_ok()) {
+            std::cerr << "Vehicle geometry load warning: " << geometry_status.message << "\n";
+        }
+        geometry_loaded = geometry_status.is_ok();
+    } else if (argc >= 4) {
+        std::cerr << "Vehicle geometry load warning: file not found: " << vehicle_cfg_path.string() << "\n";
+    }
+
+    const auto geometry_plan = geometry_loaded ? ultrasound::compile_geometry_plan(settings.vehicle_geometry)
+                                               : ultrasound::default_geometry_plan();
+    ultrasound::UltrasoundProcessor processor(config, geometry_plan);
 
     for (std::uint64_t t = 0; t <= 5'000'000; t += 50'000) {
         ultrasound::VehicleState state;
@@ -38,20 +61,17 @@ int main(int argc, char** argv) {
         (void)processor.push_vehicle_state(state);
     }
 
-    const auto frames = ultrasound::load_replay_csv(argv[1]);
+    auto frames = ultrasound::load_replay_csv(argv[1]);
     std::vector<ultrasound::FrameOutput> outputs;
     outputs.reserve(frames.size());
 
-    for (const auto& frame : frames) {
-        const auto status = processor.process_frame(frame);
+    for (auto& frame : frames) {
+        const auto timestamp_us = frame.timestamp_us;
+        auto& out = outputs.emplace_back();
+        const auto status = processor.process_frame(std::move(frame), out);
         if (!status.is_ok()) {
-            std::cerr << "Dropped frame @" << frame.timestamp_us << " reason=" << status.message << "\n";
-            continue;
-        }
-
-        const auto out = processor.last_output();
-        if (out.has_value()) {
-            outputs.push_back(*out);
+            outputs.pop_back();
+            std::cerr << "Dropped frame @" << timestamp_us << " reason=" << status.message << "\n";
         }
     }
 
@@ -60,22 +80,5 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
-    ultrasound::VisualizerSettings settings;
-    namespace fs = std::filesystem;
-    fs::path vehicle_cfg_path;
-    if (argc >= 4) {
-        vehicle_cfg_path = fs::path(argv[3]);
-    } else {
-        vehicle_cfg_path = fs::path("configs") / "vehicle_profile_reference.ini";
-    }
-    if (fs::exists(vehicle_cfg_path)) {
-        const auto geometry_status = ultrasound::load_vehicle_geometry_from_ini(vehicle_cfg_path.string(), settings.vehicle_geometry);
-        if (!geometry_status.is_ok()) {
-            std::cerr << "Vehicle geometry load warning: " << geometry_status.message << "\n";
-        }
-    } else if (argc >= 4) {
-        std::cerr << "Vehicle geometry load warning: file not found: " << vehicle_cfg_path.string() << "\n";
-    }
-
     return ultrasound::run_imgui_visualizer(outputs, settings);
 }
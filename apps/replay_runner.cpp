@@ -1,28 +1,50 @@
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "ultrasound/config.hpp"
 #include "ultrasound/config_io.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/intersection_lut_io.hpp"
 #include "ultrasound/processor.hpp"
 #include "ultrasound/replay.hpp"
 #include "ultrasound/runtime.hpp"
 
 int main(int argc, char** argv) {
-    if (argc < 3 || argc > 4) {
-        std::cerr << "Usage: uss_replay_runner <input.csv> <output.csv> [config.ini]\n";
+    if (argc < 3 || argc > 5) {
+        std::cerr << "Usage: uss_replay_runner <input.csv> <output.csv> [config.ini] [vehicle_config.ini]\n";
         return EXIT_FAILURE;
     }
 
     ultrasound::ProcessorConfig config;
-    if (argc == 4) {
+    if (argc >= 4) {
         const auto load_status = ultrasound::load_processor_config_from_ini(argv[3], config);
         if (!load_status.is_ok()) {
             std::cerr << "Config load error: " << load_status.message << "\n";
             return EXIT_FAILURE;
         }
     }
-    ultrasound::UltrasoundProcessor processor(config);
+    auto geometry_plan = ultrasound::default_geometry_plan();
+    if (argc == 5) {
+        ultrasound::VehicleGeometry geometry;
+        const auto geometry_status = ultrasound::load_vehicle_geometry_from_ini(argv[4], geometry);
+        if (!geometry_status.is_ok()) {
+            std::cerr << "Vehicle geometry load error: " << geometry_status.message << "\n";
+            return EXIT_FAILURE;
+        }
+        geometry_plan = ultrasound::compile_geometry_plan(geometry);
+    }
+    std::shared_ptr<const ultrasound::IntersectionLut> lut;
+    if (config.intersection_solver == ultrasound::IntersectionSolver::Lookup) {
+        const auto lut_status = ultrasound::load_or_build_intersection_lut(*geometry_plan, config, lut);
+        if (!lut_status.is_ok()) {
+            std::cerr << "Intersection table cache warning: " << lut_status.message << "\n";
+        }
+    }
+    ultrasound::UltrasoundProcessor processor(config, geometry_plan, lut);
 
     std::uint64_t callback_frames = 0U;
     ultrasound::register_processed_detections_callback(
@@ -40,20 +62,22 @@ int main(int argc, char** argv) {
 
     const auto frames = ultrasound::load_replay_csv(argv[1]);
     std::vector<ultrasound::FrameOutput> outputs;
-    outputs.reserve(frames.size());
+    std::vector<ultrasound::Status> statuses;
+    (void)processor.process_frames(frames, outputs, statuses);
 
-    for (const auto& frame : frames) {
-        const auto status = processor.process_frame(frame);
-        if (!status.is_ok()) {
-            std::cerr << "Dropped frame @" << frame.timestamp_us << " reason=" << status.message << "\n";
+    std::size_t kept = 0U;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        if (!statuses[i].is_ok()) {
+            std::cerr << "Dropped frame @" << frames[i].timestamp_us << " reason=" << statuses[i].message << "\n";
             continue;
         }
-        const auto out = processor.last_output();
-        if (out.has_value()) {
-            outputs.push_back(*out);
-            ultrasound::dispatch_runtime_frame(*out);
+        ultrasound::dispatch_runtime_frame(outputs[i]);
+        if (kept != i) {
+            std::swap(outputs[kept], outputs[i]);
         }
+        ++kept;
     }
+    outputs.resize(kept);
 
     ultrasound::write_output_csv(argv[2], outputs);
 
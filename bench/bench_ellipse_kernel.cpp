@@ -0,0 +1,93 @@
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ultrasound/ellipse_kernel.hpp"
+
+namespace {
+
+using ultrasound::EllipseModel;
+
+std::vector<EllipseModel> random_ellipses(std::mt19937& rng, std::size_t n) {
+    std::uniform_real_distribution<double> center(-1.0, 4.0);
+    std::uniform_real_distribution<double> axis(0.5, 5.0);
+    std::uniform_real_distribution<double> angle(-3.1, 3.1);
+    std::vector<EllipseModel> models(n);
+    for (auto& m : models) {
+        m = {center(rng), center(rng), axis(rng), axis(rng), angle(rng)};
+    }
+    return models;
+}
+
+}  // namespace
+
+// Implicit evaluation of one ellipse's 361 samples against every other model: per-point scalar calls
+// (rotation recomputed each time) vs the prepared batch kernel, scalar and SIMD.
+int main(int argc, char** argv) {
+    const int repeats = (argc > 1) ? std::atoi(argv[1]) : 200;
+    std::mt19937 rng(3U);
+    const auto models = random_ellipses(rng, 24U);
+
+    std::vector<ultrasound::PreparedEllipse> prepared;
+    std::vector<ultrasound::EllipseSampleBlock> blocks(models.size());
+    for (std::size_t i = 0; i < models.size(); ++i) {
+        prepared.push_back(ultrasound::prepare_ellipse(models[i]));
+        ultrasound::sample_ellipse(prepared[i], blocks[i]);
+    }
+    std::array<double, ultrasound::kEllipseSamples + 1U> values{};
+    constexpr std::size_t kCount = values.size();
+
+    double per_point_sum = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (std::size_t i = 0; i < models.size(); ++i) {
+            for (std::size_t j = 0; j < models.size(); ++j) {
+                for (std::size_t s = 0; s < kCount; ++s) {
+                    per_point_sum += ultrasound::ellipse_implicit_value(models[j], blocks[i].x[s], blocks[i].y[s]);
+                }
+            }
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    double scalar_sum = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        for (std::size_t i = 0; i < models.size(); ++i) {
+            for (std::size_t j = 0; j < models.size(); ++j) {
+                ultrasound::ellipse_implicit_values_scalar(prepared[j], blocks[i].x.data(), blocks[i].y.data(),
+                                                           values.data(), kCount);
+                scalar_sum += values[kCount / 2U];
+            }
+        }
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    double batch_sum = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        for (std::size_t i = 0; i < models.size(); ++i) {
+            for (std::size_t j = 0; j < models.size(); ++j) {
+                ultrasound::ellipse_implicit_values(prepared[j], blocks[i].x.data(), blocks[i].y.data(),
+                                                    values.data(), kCount);
+                batch_sum += values[kCount / 2U];
+            }
+        }
+    }
+    const auto t3 = std::chrono::steady_clock::now();
+
+    if (scalar_sum != batch_sum) {
+        std::cerr << "batch kernel diverged from scalar kernel\n";
+        return EXIT_FAILURE;
+    }
+    const double evaluations = static_cast<double>(repeats) * static_cast<double>(models.size() * models.size() * kCount);
+    const auto ns_per_eval = [evaluations](auto dt) {
+        return std::chrono::duration<double, std::nano>(dt).count() / evaluations;
+    };
+    std::cout << "per_point_ns,prepared_scalar_ns,prepared_batch_ns,speedup_vs_per_point\n";
+    std::cout << ns_per_eval(t1 - t0) << "," << ns_per_eval(t2 - t1) << "," << ns_per_eval(t3 - t2) << ","
+              << (ns_per_eval(t1 - t0) / ns_per_eval(t3 - t2)) << "\n";
+    std::cerr << "checksum " << per_point_sum << "\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ultrasound/spatial_index.hpp"
+
+namespace {
+
+using Point = std::array<double, 2U>;
+
+bool has_support_near(const std::vector<Point>& detections, const Point& candidate, double radius_m) {
+    const double radius_sq = radius_m * radius_m;
+    for (const auto& p : detections) {
+        const double dx = p[0] - candidate[0];
+        const double dy = p[1] - candidate[1];
+        if ((dx * dx + dy * dy) <= radius_sq) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<Point> random_points(std::mt19937& rng, std::size_t n) {
+    // Detections around a 5.5 m sensing envelope of a ~5 m vehicle.
+    std::uniform_real_distribution<double> x(-6.5, 9.5);
+    std::uniform_real_distribution<double> y(-6.5, 6.5);
+    std::vector<Point> points(n);
+    for (auto& p : points) {
+        p = {x(rng), y(rng)};
+    }
+    return points;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int repeats = (argc > 1) ? std::atoi(argv[1]) : 200;
+    constexpr double kRadiusM = 0.55;
+    std::mt19937 rng(7U);
+
+    std::cout << "candidates,linear_us,grid_us,speedup\n";
+    for (const std::size_t per_method : {16U, 32U, 64U, 128U, 256U, 512U}) {
+        const auto tracing = random_points(rng, per_method);
+        const auto fov = random_points(rng, per_method);
+        const auto ellipse = random_points(rng, per_method);
+        std::vector<Point> candidates;
+        candidates.insert(candidates.end(), tracing.begin(), tracing.end());
+        candidates.insert(candidates.end(), fov.begin(), fov.end());
+        candidates.insert(candidates.end(), ellipse.begin(), ellipse.end());
+
+        std::uint64_t linear_hits = 0U;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            for (const auto& c : candidates) {
+                const int count = (has_support_near(tracing, c, kRadiusM) ? 1 : 0) +
+                                  (has_support_near(fov, c, kRadiusM) ? 1 : 0) +
+                                  (has_support_near(ellipse, c, kRadiusM) ? 1 : 0);
+                linear_hits += (count >= 2) ? 1U : 0U;
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        std::uint64_t grid_hits = 0U;
+        ultrasound::MethodSupportGrid grid(kRadiusM);
+        for (int r = 0; r < repeats; ++r) {
+            grid.clear(candidates.size());
+            grid.insert_all(tracing, 1U);
+            grid.insert_all(fov, 2U);
+            grid.insert_all(ellipse, 4U);
+            for (const auto& c : candidates) {
+                const std::uint8_t mask = grid.support_mask(c, 7U);
+                const int count = (mask & 1U) + ((mask >> 1U) & 1U) + ((mask >> 2U) & 1U);
+                grid_hits += (count >= 2) ? 1U : 0U;
+            }
+        }
+        const auto t2 = std::chrono::steady_clock::now();
+
+        if (linear_hits != grid_hits) {
+            std::cerr << "support mismatch at " << candidates.size() << " candidates\n";
+            return EXIT_FAILURE;
+        }
+        const double linear_us =
+            std::chrono::duration<double, std::micro>(t1 - t0).count() / static_cast<double>(repeats);
+        const double grid_us =
+            std::chrono::duration<double, std::micro>(t2 - t1).count() / static_cast<double>(repeats);
+        std::cout << candidates.size() << "," << linear_us << "," << grid_us << "," << (linear_us / grid_us) << "\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ultrasound/spatial_index.hpp"
+
+namespace ultrasound {
+
+// Table-melt clustering: detections joined by any chain of neighbours within `radius_m` form one cluster,
+// reported as its centroid. Clusters are emitted in order of their lowest input index and each centroid is
+// accumulated in input order, so the result matches the dense flood-fill formulation bit for bit.
+// Neighbour pairs come from a spatial hash grid and are merged with union-find, so cost is near-linear in
+// the number of detections. Scratch buffers are kept between calls.
+class DetectionClusterer {
+  public:
+    void cluster(const std::vector<std::array<double, 2U>>& in, double radius_m,
+                 std::vector<std::array<double, 2U>>& out);
+
+  private:
+    std::int32_t find_root(std::int32_t i);
+
+    SpatialHashGrid grid_{1.0};
+    double cell_size_m_{1.0};
+    std::vector<std::int32_t> parent_{};
+    std::vector<std::int32_t> label_{};
+    std::vector<double> sum_x_{};
+    std::vector<double> sum_y_{};
+    std::vector<double> count_{};
+};
+
+}  // namespace ultrasound
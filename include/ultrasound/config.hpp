@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -18,6 +19,18 @@ enum class ProcessingMethod : std::uint8_t {
     All = 3
 };
 
+enum class IntersectionSolver : std::uint8_t {
+    Sampled = 0,
+    Analytic = 1,
+    // Coarse sweep + Brent refinement per pair (adaptive_ellipse_intersections()).
+    Adaptive = 2,
+    // Per-geometry intersection table (IntersectionLut) for ellipse pairs; FOV pairs use the analytic solver.
+    Lookup = 3
+};
+
+// Vehicle states an UltrasoundProcessor keeps for pose interpolation; older ones are dropped.
+inline constexpr std::size_t kMaxVehicleStates = 64U;
+
 struct ProcessorConfig {
     float n_sigma_valeo{3.0F};
     bool use_legacy_valeo_bugfix{false};
@@ -26,6 +39,36 @@ struct ProcessorConfig {
     float min_range_m{0.00001F};
     float max_range_m{5.5F};
     float cluster_radius_m{0.35F};
+    IntersectionSolver intersection_solver{IntersectionSolver::Sampled};
+    // Merge identical ellipses and skip pairs sharing both foci before pairwise intersection.
+    bool skip_confocal_pairs{true};
+    // Candidate-pair pruning for ellipse/FOV intersection: skip pairs from different signal-way groups, and
+    // pairs whose nearest sensors are more than max_pair_sensor_gap neighbouring-sensor steps apart
+    // (GeometryPlan::sensor_gaps; 0 keeps every pair).
+    bool prune_cross_group_pairs{false};
+    std::uint8_t max_pair_sensor_gap{0U};
+    // LOOKUP solver: grid nodes per range axis over [min_range_m, max_range_m], Newton polish of each
+    // interpolated root, and an optional table cache file for the apps (empty: always build).
+    std::uint16_t lut_resolution{32U};
+    bool lut_newton_polish{true};
+    std::string lut_cache_path{};
+    // LRU cache of ellipse/FOV pair intersections across frames, keyed by both signal ways and their ranges (0
+    // entries disables it). A positive quantization step snaps ranges to its multiples before the models are
+    // built, so near-identical ranges share entries; at 0 only bit-identical ranges do and results are unchanged.
+    std::uint32_t pair_cache_capacity{4096U};
+    float pair_cache_quantization_m{0.0F};
+    // Reuse the previous frame's detections when the filtered signal ways (group, id and bit-identical range, in
+    // arrival order) are unchanged.
+    bool reuse_unchanged_frames{true};
+    // Threads used by UltrasoundProcessor::process_frames(), the caller included, and by a ProcessorFleet's pool;
+    // 0 uses every hardware thread.
+    std::uint16_t worker_threads{0U};
+    // process_frame() splits a frame's ellipse or FOV pairs across the worker threads once there are at least this
+    // many of them (0 keeps every frame on the calling thread). Results do not depend on it.
+    std::uint32_t parallel_pair_threshold{64U};
+    // States UltrasoundProcessor::offer_vehicle_state() can queue ahead of the next frame (rounded up to a power
+    // of two), at most kMaxVehicleStates: the processor keeps no more than that for interpolation.
+    std::uint32_t vehicle_state_channel_capacity{static_cast<std::uint32_t>(kMaxVehicleStates)};
     bool strict_monotonic_timestamps{true};
 };
 
@@ -20,6 +20,23 @@ struct Diagnostics {
     std::uint64_t invalid_input_frames{0U};
     std::uint64_t filtered_signal_ways{0U};
     std::uint64_t clustered_detections{0U};
+    // Ellipse pair evaluations avoided by merging duplicate models and skipping confocal pairs.
+    std::uint64_t skipped_ellipse_pairs{0U};
+    // Ellipse/FOV model pairs dropped by the candidate-pair generator, and pairs actually evaluated.
+    std::uint64_t pruned_model_pairs{0U};
+    std::uint64_t visited_model_pairs{0U};
+    // LOOKUP solver: ellipse pairs answered from the table, and pairs left to the closed-form solver.
+    std::uint64_t lut_lookups{0U};
+    std::uint64_t lut_fallbacks{0U};
+    // Ellipse/FOV model pairs answered from the cross-frame pair cache, and pairs computed (and then cached).
+    std::uint64_t pair_cache_hits{0U};
+    std::uint64_t pair_cache_misses{0U};
+    // Frames whose signal ways matched the previous frame, served without post-processing.
+    std::uint64_t reused_frames{0U};
+    // Ellipse/FOV pair sets large enough to be split across threads within their frame.
+    std::uint64_t parallel_pair_passes{0U};
+    // Vehicle states offered or queued through a ProcessorPipeline that failed the processor's monotonic check.
+    std::uint64_t rejected_vehicle_states{0U};
     StageTimingUs last_stage_timing_us{};
     StageTimingUs cumulative_stage_timing_us{};
     bool replay_mode{true};
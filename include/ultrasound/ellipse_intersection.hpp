@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace ultrasound {
+
+struct EllipseModel {
+    double cx{0.0};
+    double cy{0.0};
+    double axis_a{1.0};
+    double axis_b{1.0};
+    double theta{0.0};
+};
+
+// Intersections of ellipse `a` with ellipse `b`, expressed as points on `a`.
+// `closest_point`/`closest_error` hold the point of `a` with the smallest |implicit| w.r.t. `b`,
+// which callers use to keep near-miss pairs.
+struct EllipsePairSolution {
+    std::array<std::array<double, 2U>, 4U> points{};
+    std::size_t point_count{0U};
+    std::array<double, 2U> closest_point{};
+    double closest_error{0.0};
+};
+
+// {cos, sin} of `param_t`. Kept out of line so the calls always reach the run-time libm: folded at compile
+// time, as a constant loop could be, a few of them round differently. Every ellipse sample point and the shared
+// sample table go through it, which keeps table samples bit-identical to ellipse_point().
+std::array<double, 2U> unit_circle_point(double param_t);
+std::array<double, 2U> ellipse_point(const EllipseModel& e, double param_t);
+double ellipse_implicit_value(const EllipseModel& e, double x_m, double y_m);
+double ellipse_implicit_error(const EllipseModel& e, double x_m, double y_m);
+
+// Legacy traverse approximation: 360-sample march along `a` with 20 bisection steps per sign change of `b`.
+void sample_ellipse_intersections(const EllipseModel& a,
+                                  const EllipseModel& b,
+                                  std::vector<std::array<double, 2U>>& roots);
+
+// Closed-form solve of the two-conic quartic, dispatched by model type: circle pairs (monostatic signal ways)
+// go to solve_circle_circle(), and a circle against an ellipse uses a reduced quartic without the relative
+// rotation. Returns false for near-degenerate pairs (concentric circles, coincident ellipses) where callers
+// should fall back to sampling.
+bool solve_ellipse_intersections(const EllipseModel& a, const EllipseModel& b, EllipsePairSolution& solution);
+
+// Common chord of two circles (axis_a == axis_b, axis_a used as the radius); no root finding involved.
+bool solve_circle_circle(const EllipseModel& a, const EllipseModel& b, EllipsePairSolution& solution);
+
+}  // namespace ultrasound
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "ultrasound/ellipse_intersection.hpp"
+
+namespace ultrasound {
+
+// Ellipse with its rotation, clamped squared axes and axis-aligned bounding box precomputed, built once per
+// signal way. The squared axes are divided by rather than inverted, so batch results match
+// ellipse_implicit_value() bit for bit.
+struct PreparedEllipse {
+    EllipseModel model{};
+    double cos_theta{1.0};
+    double sin_theta{0.0};
+    double axis_a_sq{1.0};
+    double axis_b_sq{1.0};
+    double min_x_m{0.0};
+    double max_x_m{0.0};
+    double min_y_m{0.0};
+    double max_y_m{0.0};
+    // axis_a == axis_b, e.g. every monostatic signal way.
+    bool circle{false};
+};
+
+PreparedEllipse prepare_ellipse(const EllipseModel& e);
+
+// Bounds [lo, hi] on the implicit value of the circle `b` at every point of `a`, from the exact centre distance
+// range when `a` is a circle too and from a's bounding box otherwise. The bounds are widened to cover rounding
+// in the sampled kernels. Returns false when `b` is not a circle.
+bool circle_implicit_range(const PreparedEllipse& a, const PreparedEllipse& b, double& lo, double& hi);
+
+// Sample parameters t = s / kEllipseSamples * 2*pi for s = 0..kEllipseSamples; the last closes the loop.
+constexpr std::size_t kEllipseSamples = 360U;
+
+// cos/sin of every sample parameter, computed once and shared by all ellipses.
+struct UnitCircleTable {
+    std::array<double, kEllipseSamples + 1U> cos_t{};
+    std::array<double, kEllipseSamples + 1U> sin_t{};
+};
+
+const UnitCircleTable& unit_circle_table();
+
+// Sample points of one ellipse, structure-of-arrays.
+struct EllipseSampleBlock {
+    alignas(32) std::array<double, kEllipseSamples + 1U> x{};
+    alignas(32) std::array<double, kEllipseSamples + 1U> y{};
+};
+
+// Same points as ellipse_point() at the sample parameters, from the shared table with multiply-adds only.
+void sample_ellipse(const PreparedEllipse& e, EllipseSampleBlock& out);
+
+std::array<double, 2U> ellipse_point(const PreparedEllipse& e, double param_t);
+double ellipse_implicit_value(const PreparedEllipse& e, double x_m, double y_m);
+
+// out[i] = implicit value of `e` at (x[i], y[i]). Uses AVX2 or SSE2 when the build targets them;
+// every path produces the same bits as the scalar kernel.
+void ellipse_implicit_values(const PreparedEllipse& e, const double* x, const double* y, double* out, std::size_t count);
+void ellipse_implicit_values_scalar(const PreparedEllipse& e,
+                                    const double* x,
+                                    const double* y,
+                                    double* out,
+                                    std::size_t count);
+
+// sample_ellipse_intersections() over precomputed samples of `a`, so one block serves every partner of `a`.
+void sample_ellipse_intersections(const PreparedEllipse& a,
+                                  const EllipseSampleBlock& a_samples,
+                                  const PreparedEllipse& b,
+                                  std::vector<std::array<double, 2U>>& roots);
+// Same, from b's implicit values at a's samples already evaluated by the caller.
+void sample_ellipse_intersections(const PreparedEllipse& a,
+                                  const std::array<double, kEllipseSamples + 1U>& values,
+                                  const PreparedEllipse& b,
+                                  std::vector<std::array<double, 2U>>& roots);
+
+// Coarse-to-fine alternative to the fixed sampler: a 36-sample sweep of b's implicit value along `a` brackets
+// sign changes, which Brent's method refines, and local minima of |value|, which Brent's minimiser refines
+// into tangencies, close root pairs or the closest approach. Needs roughly a tenth of the fixed sampler's
+// implicit evaluations; `evaluations` receives the count. Returns false for coincident models or more than
+// four roots, where callers fall back to the fixed sampler.
+bool adaptive_ellipse_intersections(const PreparedEllipse& a,
+                                    const PreparedEllipse& b,
+                                    EllipsePairSolution& solution,
+                                    std::size_t* evaluations = nullptr);
+
+}  // namespace ultrasound
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ultrasound/sensor_pair_table.hpp"
+#include "ultrasound/vehicle_geometry.hpp"
+
+namespace ultrasound {
+
+// Immutable, precompiled form of a VehicleGeometry. Processors only read from it, so one plan can be
+// shared by every processor instance configured for the same vehicle variant.
+struct GeometryPlan {
+    // Sensors, structure-of-arrays, indexed by USS sensor id.
+    std::vector<double> sensor_x_m{};
+    std::vector<double> sensor_y_m{};
+    std::vector<double> sensor_mounting_rad{};
+    std::vector<double> sensor_fov_rad{};
+    std::vector<double> sensor_cos_mounting{};
+    std::vector<double> sensor_sin_mounting{};
+
+    // Contour edges (i, j = i - 1) for the crossing-number test: a horizontal ray from (x, y) crosses
+    // edge k when (edge_y0[k] > y) != (edge_y1[k] > y) and x < edge_x0[k] + edge_dx_dy[k] * (y - edge_y0[k]).
+    std::vector<double> edge_x0{};
+    std::vector<double> edge_y0{};
+    std::vector<double> edge_y1{};
+    std::vector<double> edge_dx_dy{};
+    double contour_min_x_m{0.0};
+    double contour_max_x_m{0.0};
+    double contour_min_y_m{0.0};
+    double contour_max_y_m{0.0};
+
+    // Raster over the bounding box. A cell that no edge comes near stores the crossing-number answer for its
+    // whole area; only Boundary cells fall through to the per-edge test.
+    enum class ContourCell : std::uint8_t { Outside = 0, Inside = 1, Boundary = 2 };
+    std::size_t contour_cells_x{0U};
+    std::size_t contour_cells_y{0U};
+    double contour_inv_cell_w{0.0};
+    double contour_inv_cell_h{0.0};
+    std::vector<ContourCell> contour_cells{};
+
+    SensorPairTable pairs{};
+
+    // Positions between two sensors (row-major by sensor id) along the chain of neighbouring sensors, which run
+    // in id order around the contour. Consecutive ids more than twice the median spacing apart, such as the
+    // front and rear corner sensors at either end of a side, are not neighbours; kNoSensorPath marks sensors the
+    // chain does not connect.
+    static constexpr std::uint8_t kNoSensorPath = 255U;
+    std::vector<std::uint8_t> sensor_gaps{};
+};
+
+std::shared_ptr<const GeometryPlan> compile_geometry_plan(const VehicleGeometry& geometry);
+
+// Built-in reference vehicle (matches configs/vehicle_profile_reference.ini); compiled once and shared.
+std::shared_ptr<const GeometryPlan> default_geometry_plan();
+
+// Bounding-box reject, then the contour raster; the crossing-number test only runs near an edge.
+bool is_inside_vehicle_contour(const GeometryPlan& plan, double x_m, double y_m);
+// Reference crossing-number test over every contour edge.
+bool is_inside_vehicle_contour_exact(const GeometryPlan& plan, double x_m, double y_m);
+
+}  // namespace ultrasound
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ultrasound/ellipse_intersection.hpp"
+#include "ultrasound/ellipse_kernel.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/pair_candidates.hpp"
+#include "ultrasound/sensor_pair_table.hpp"
+
+namespace ultrasound {
+
+// Ellipse of a signal way at `range_m`: foci at the two sensors, axis_a equal to the range. Empty when the
+// range does not exceed the half baseline.
+std::optional<EllipseModel> signal_way_ellipse(const SensorPairGeometry& pair, double range_m);
+
+// Intersections of the ellipses of every two sensor pairs (foci) of one geometry, tabulated over both ranges on a
+// `resolution` x `resolution` grid spanning [min_range_m, max_range_m]. The ellipse of a signal way depends only
+// on its unordered sensor pair and range, so a table serves both directions of each pair and both orders of
+// the two signal ways. Built once per GeometryPlan and shared read-only like the plan.
+struct IntersectionLut {
+    static constexpr std::uint8_t kUndefined = 0xFFU;
+    static constexpr std::size_t kMaxPoints = 4U;
+
+    std::uint64_t geometry_fingerprint{0U};
+    std::size_t resolution{0U};
+    double min_range_m{0.0};
+    double max_range_m{0.0};
+    double step_m{0.0};
+    std::size_t sensor_count{0U};
+    // Dense index of each unordered sensor pair (lo * sensor_count + hi); -1 when no signal way uses it.
+    std::vector<std::int32_t> foci_index{};
+    std::size_t foci_count{0U};
+    // Table of each foci pair (fa * foci_count + fb, fa < fb); -1 when the ellipses cannot meet at any range.
+    std::vector<std::int32_t> table_index{};
+    // Per node (table, range index of fa, range index of fb): root count, or kUndefined where a range is below
+    // the half baseline, and kMaxPoints point slots.
+    std::vector<std::uint8_t> counts{};
+    std::vector<std::array<float, 2U>> points{};
+};
+
+// Hash of the sensor pair geometry a table depends on; a cached table is only valid for a matching plan.
+std::uint64_t intersection_lut_fingerprint(const GeometryPlan& plan);
+
+std::shared_ptr<const IntersectionLut> build_intersection_lut(const GeometryPlan& plan,
+                                                              double min_range_m,
+                                                              double max_range_m,
+                                                              std::size_t resolution);
+
+// True when `lut` was built for `plan` with exactly this grid, so it can stand in for a fresh build.
+bool intersection_lut_matches(const IntersectionLut& lut,
+                              const GeometryPlan& plan,
+                              double min_range_m,
+                              double max_range_m,
+                              std::size_t resolution);
+
+// Bilinear interpolation of the roots of models `a` and `b` from the four surrounding grid nodes. Returns false,
+// leaving the pair to an exact solver, when a range is off the grid, the pair is not tabulated, or the nodes
+// disagree on the number of roots or hold none.
+bool lookup_intersections(const IntersectionLut& lut,
+                          const ModelOrigin& a,
+                          double range_a_m,
+                          const ModelOrigin& b,
+                          double range_b_m,
+                          EllipsePairSolution& solution);
+
+// Two Newton steps on both implicit equations, moving `p` towards the nearby intersection of `a` and `b`.
+// False when the point did not settle on both ellipses (interpolated from a cell the roots cross too fast).
+bool polish_intersection(const PreparedEllipse& a, const PreparedEllipse& b, std::array<double, 2U>& p);
+
+}  // namespace ultrasound
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "ultrasound/config.hpp"
+#include "ultrasound/error.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/intersection_lut.hpp"
+
+namespace ultrasound {
+
+// Binary cache of a built table, in native byte order; meant for reuse on the machine that wrote it.
+Status save_intersection_lut(const IntersectionLut& lut, const std::string& path);
+Status load_intersection_lut(const std::string& path, std::shared_ptr<const IntersectionLut>& lut);
+
+// Reuses config.lut_cache_path when it holds a table for `plan` with the configured grid, otherwise builds the
+// table and, with a cache path set, writes it back. `lut` is valid even when writing the cache fails.
+Status load_or_build_intersection_lut(const GeometryPlan& plan,
+                                      const ProcessorConfig& config,
+                                      std::shared_ptr<const IntersectionLut>& lut);
+
+}  // namespace ultrasound
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ultrasound {
+
+// Identity of one ellipse model across frames: group, signal way and range. With `quantization_m` > 0 the
+// range is keyed (and the caller must build the model) at the nearest multiple of the step; otherwise the
+// exact float bits are keyed, so only bit-identical ranges match.
+std::uint64_t pair_cache_model_key(std::uint8_t group_id,
+                                   std::uint8_t signal_way_id,
+                                   float distance_m,
+                                   float quantization_m);
+// Range a model is built from under `quantization_m` (the distance itself when the step is 0).
+double pair_cache_range(float distance_m, float quantization_m);
+
+// Ordered model pair; (a, b) and (b, a) are different entries because the sampled solver is not symmetric.
+struct PairCacheKey {
+    std::uint64_t a{0U};
+    std::uint64_t b{0U};
+
+    bool operator==(const PairCacheKey& other) const {
+        return a == other.a && b == other.b;
+    }
+};
+
+// Contour-filtered candidate points of one pair: points[0, deferred_begin) are pushed when the pair is
+// visited, the rest after every pair of the frame when the collector defers tolerance hits.
+struct PairIntersections {
+    std::vector<std::array<double, 2U>> points{};
+    std::size_t deferred_begin{0U};
+
+    void clear() {
+        points.clear();
+        deferred_begin = 0U;
+    }
+};
+
+// Bounded least-recently-used map from model pairs to their intersections. Open addressing over a power-of-two
+// slot array plus an intrusive recency list; entry buffers are reused on eviction, so a warm cache does not
+// allocate.
+class PairIntersectionCache {
+  public:
+    explicit PairIntersectionCache(std::size_t capacity = 0U);
+
+    std::size_t capacity() const {
+        return entries_.size();
+    }
+    std::size_t size() const {
+        return size_;
+    }
+    void clear();
+
+    // Marks the entry most recently used; the pointer is valid until the next insert() or clear().
+    const PairIntersections* find(const PairCacheKey& key);
+    // Stores a copy of `value`, evicting the least recently used entry when full. No-op at capacity 0.
+    void insert(const PairCacheKey& key, const PairIntersections& value);
+
+  private:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFU;
+
+    struct Entry {
+        PairCacheKey key{};
+        PairIntersections value{};
+        std::uint32_t prev{kNone};
+        std::uint32_t next{kNone};
+    };
+
+    std::size_t home_slot(const PairCacheKey& key) const;
+    std::size_t find_slot(const PairCacheKey& key) const;
+    void erase_slot(std::size_t slot);
+    void unlink(std::uint32_t entry);
+    void push_front(std::uint32_t entry);
+
+    std::vector<Entry> entries_{};
+    // Entry index per slot, kNone when empty.
+    std::vector<std::uint32_t> slots_{};
+    std::size_t size_{0U};
+    std::uint32_t head_{kNone};
+    std::uint32_t tail_{kNone};
+};
+
+}  // namespace ultrasound
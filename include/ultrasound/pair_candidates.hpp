@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ultrasound/ellipse_kernel.hpp"
+
+namespace ultrasound {
+
+// Signal way a model was built from: its group and unordered sensor pair (the foci of an ellipse).
+struct ModelOrigin {
+    std::uint8_t group{0U};
+    std::uint8_t sensor_lo{0U};
+    std::uint8_t sensor_hi{0U};
+};
+
+ModelOrigin make_model_origin(std::uint8_t group, std::uint8_t tx, std::uint8_t rx);
+bool same_sensor_pair(const ModelOrigin& a, const ModelOrigin& b);
+
+struct PairPruningRules {
+    // Pairs sharing both sensors; only sound for foci-built ellipses, which are then confocal and never cross.
+    bool skip_same_sensor_pair{false};
+    bool skip_cross_group{false};
+    // Largest allowed distance between the nearest sensors of two models, in positions along neighbouring
+    // sensors as given by `sensor_gaps` (GeometryPlan::sensor_gaps, `sensor_count` squared entries); 0 disables
+    // the rule.
+    std::uint8_t max_sensor_gap{0U};
+    const std::vector<std::uint8_t>* sensor_gaps{nullptr};
+    std::size_t sensor_count{0U};
+};
+
+struct ModelPair {
+    std::uint32_t i{0U};
+    std::uint32_t j{0U};
+};
+
+struct PairGenerationStats {
+    std::uint64_t same_sensor_pair{0U};
+    std::uint64_t pruned{0U};
+    std::uint64_t emitted{0U};
+};
+
+// Emits every pair i < j, in lexicographic order, that survives `rules` and a geometric quick-reject. The
+// quick-reject (centre distance vs. axis sum, bounding boxes, circle distance range) only drops pairs where the
+// implicit value of model j exceeds `implicit_limit` along all of model i, so it never changes results.
+void generate_candidate_pairs(const std::vector<PreparedEllipse>& models,
+                              const std::vector<ModelOrigin>& origins,
+                              const PairPruningRules& rules,
+                              double implicit_limit,
+                              std::vector<ModelPair>& out,
+                              PairGenerationStats& stats);
+
+}  // namespace ultrasound
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ultrasound/ellipse_kernel.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/pair_cache.hpp"
+#include "ultrasound/processor_workspace.hpp"
+
+namespace ultrasound {
+
+// Sampled evaluation of one model pair against a's samples. Points inside the vehicle contour are dropped.
+
+// Traverse roots (sign changes of b's implicit value along a) and the tolerance sweep from one evaluation of b
+// at a's samples. Roots fill `result` first; tolerance hits follow from result.deferred_begin on, then the
+// sample closest to b when it is within `best_limit`. Callers that push every pair's roots before any pair's
+// deferred points reproduce a full traverse pass followed by a full tolerance pass.
+void collect_pair_fused(const GeometryPlan& plan,
+                        const PreparedEllipse& a,
+                        const EllipseSampleBlock& a_samples,
+                        const PreparedEllipse& b,
+                        PairScratch& scratch,
+                        double tolerance,
+                        double best_limit,
+                        PairIntersections& result);
+
+// Tolerance sweep only (no traverse roots), as used for FOV models.
+void collect_pair_tolerance_hits(const GeometryPlan& plan,
+                                 const EllipseSampleBlock& a_samples,
+                                 const PreparedEllipse& b,
+                                 PairScratch& scratch,
+                                 double tolerance,
+                                 double best_limit,
+                                 PairIntersections& result);
+
+}  // namespace ultrasound
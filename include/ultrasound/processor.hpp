@@ -1,34 +1,141 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 
 #include "ultrasound/config.hpp"
 #include "ultrasound/diagnostics.hpp"
 #include "ultrasound/error.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/intersection_lut.hpp"
+#include "ultrasound/pair_cache.hpp"
+#include "ultrasound/processor_workspace.hpp"
+#include "ultrasound/spsc_ring.hpp"
+#include "ultrasound/thread_pool.hpp"
 #include "ultrasound/types.hpp"
+#include "ultrasound/vehicle_geometry.hpp"
 
 namespace ultrasound {
 
 class UltrasoundProcessor {
   public:
     explicit UltrasoundProcessor(ProcessorConfig config = ProcessorConfig{});
+    UltrasoundProcessor(ProcessorConfig config, const VehicleGeometry& geometry);
+    UltrasoundProcessor(ProcessorConfig config, std::shared_ptr<const GeometryPlan> plan);
+    // With the LOOKUP solver, `lut` is shared as is when it was built for `plan`; otherwise (or when null) the
+    // processor builds its own table from the config's range limits and resolution.
+    UltrasoundProcessor(ProcessorConfig config,
+                        std::shared_ptr<const GeometryPlan> plan,
+                        std::shared_ptr<const IntersectionLut> lut);
 
+    // Called on the thread that processes frames.
     Status push_vehicle_state(const VehicleState& state);
+    // Wait-free producer side of the vehicle-state channel, callable from one other thread (e.g. odometry) while
+    // frames are processed. Each frame first takes in every state offered so far, applying the same monotonic
+    // check as push_vehicle_state() (rejects count as Diagnostics::rejected_vehicle_states). Returns false, and
+    // counts a vehicle_state_overflows(), when config.vehicle_state_channel_capacity states are already waiting.
+    bool offer_vehicle_state(const VehicleState& state);
+    // States offer_vehicle_state() refused; readable from any thread.
+    std::uint64_t vehicle_state_overflows() const;
+    // Processes a frame and retains the result, readable through last_output().
     Status process_frame(const FrameInput& input);
+    // Processes a frame into `output`, reusing its buffers. Nothing is retained: last_output() still refers
+    // to the last frame processed through the retaining overload. `output` is untouched on failure.
+    Status process_frame(const FrameInput& input, FrameOutput& output);
+    // Consuming overloads: valid entries are compacted in place and moved, grid map included, into the
+    // output. On success `input` is left valid but unspecified; on failure it is untouched.
+    Status process_frame(FrameInput&& input);
+    Status process_frame(FrameInput&& input, FrameOutput& output);
 
-    std::optional<FrameOutput> last_output() const;
+    // Batch processing with results bit-identical to calling process_frame(inputs[i], outputs[i]) in order.
+    // Admission, pose interpolation, filtering and frame reuse run sequentially; post-processing of the frames
+    // fans out over config.worker_threads threads. outputs[i] is meaningful only where statuses[i] is ok;
+    // returns the first failure, if any. Nothing is retained in last_output().
+    Status process_frames(std::span<const FrameInput> inputs, std::vector<FrameOutput>& outputs, std::vector<Status>& statuses);
+
+    // Valid until the next retaining process_frame() call, which overwrites it in place.
+    const std::optional<FrameOutput>& last_output() const;
     Diagnostics diagnostics() const;
+    const std::shared_ptr<const GeometryPlan>& geometry_plan() const;
+    // Null unless the LOOKUP solver is configured.
+    const std::shared_ptr<const IntersectionLut>& intersection_lut() const;
 
   private:
+    friend class ProcessorPipeline;
+
+    // `consumed` is non-null (and aliases `input`) when the caller handed the frame over.
+    Status run_frame(const FrameInput& input, FrameInput* consumed, FrameOutput* caller_output);
+    // Moves the states offered through the channel into state_queue_.
+    void drain_vehicle_states();
     std::optional<Pose2d> interpolate_pose(std::uint64_t timestamp_us) const;
-    ProcessedDetections post_process(const std::vector<SignalWay>& signal_ways) const;
+    // Ordered per-frame stages. admit_frame() validates the frame and interpolates its pose; convert_frame()
+    // filters the input into `output`; post_process_frame() fills output.processed, from the previous frame when
+    // `reuse`; publish_frame() updates the frame counters and stage timings.
+    Status admit_frame(const FrameInput& input, Pose2d& pose, StageTimingUs& timing);
+    void convert_frame(const FrameInput& input, FrameInput* consumed, const Pose2d& pose, FrameOutput& output);
+    void post_process_frame(FrameOutput& output, bool reuse, Diagnostics& diagnostics);
+    static void publish_frame(const FrameOutput& output, StageTimingUs& timing, Diagnostics& diagnostics);
+    // Adds counters a pipeline stage kept on the side to the processor's.
+    void absorb_stage_diagnostics(const Diagnostics& from);
+    // True when the filtered signal ways match the last post-processed frame, whose detections can be reused.
+    bool matches_previous_frame(const std::vector<SignalWay>& signal_ways);
+    // Hands out the pool for parallel pair passes, creating it on first call.
+    using PairPoolSource = std::function<ThreadPool&()>;
+    // Pure function of the signal ways given the scratch state; counters go to `diagnostics`. Large pair sets
+    // are split across the pool from `pair_pool` when it is set; it is only called for such a set.
+    void post_process(const std::vector<SignalWay>& signal_ways,
+                      ProcessedDetections& out,
+                      ProcessorWorkspace& ws,
+                      PairIntersectionCache& pair_cache,
+                      Diagnostics& diagnostics,
+                      const PairPoolSource& pair_pool) const;
+    ThreadPool& thread_pool();
+
+    // Scratch of process_frames(): per-thread post-processing state for the pool's background threads (the
+    // calling thread uses the processor's own), and per-frame bookkeeping.
+    struct BatchWorker {
+        ProcessorWorkspace workspace{};
+        PairIntersectionCache pair_cache{};
+        Diagnostics diagnostics{};
+    };
+    struct BatchScratch {
+        std::vector<BatchWorker> workers{};
+        std::vector<std::size_t> sources{};
+        std::vector<std::size_t> computed{};
+        std::vector<StageTimingUs> timings{};
+    };
 
     ProcessorConfig config_{};
+    std::shared_ptr<const GeometryPlan> plan_{};
+    std::shared_ptr<const IntersectionLut> lut_{};
+    // Ellipse pair results kept across frames; disabled at capacity 0.
+    PairIntersectionCache pair_cache_{};
     Diagnostics diagnostics_{};
     std::deque<VehicleState> state_queue_{};
+    // Producer: offer_vehicle_state(); consumer: the frame-processing thread. Held by pointer so the processor
+    // stays movable.
+    struct VehicleStateChannel {
+        explicit VehicleStateChannel(std::size_t capacity) : ring(capacity) {}
+        SpscRing<VehicleState> ring;
+        std::atomic<std::uint64_t> overflows{0U};
+    };
+    std::unique_ptr<VehicleStateChannel> state_channel_{};
     std::optional<FrameOutput> last_output_{};
     std::uint64_t last_timestamp_us_{0U};
+    ProcessorWorkspace workspace_{};
+    std::vector<std::uint64_t> previous_frame_keys_{};
+    ProcessedDetections previous_detections_{};
+    bool has_previous_detections_{false};
+    // Created on first use by process_frames() or a parallel pair pass.
+    std::shared_ptr<ThreadPool> pool_{};
+    BatchScratch batch_{};
 };
 
 }  // namespace ultrasound
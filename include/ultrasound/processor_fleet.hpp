@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "ultrasound/config.hpp"
+#include "ultrasound/error.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/intersection_lut.hpp"
+#include "ultrasound/processor.hpp"
+#include "ultrasound/types.hpp"
+#include "ultrasound/work_stealing_pool.hpp"
+
+namespace ultrasound {
+
+struct FleetFrameResult {
+    std::uint64_t timestamp_us{0U};
+    Status status{};
+    // Meaningful only when status is ok.
+    FrameOutput output{};
+};
+
+// Throughput of one stream: frames per second of its own processing time, i.e. per busy core.
+struct FleetStreamStats {
+    std::uint32_t stream_id{0U};
+    std::uint64_t processed_frames{0U};
+    std::uint64_t failed_frames{0U};
+    std::uint64_t busy_us{0U};
+    double frames_per_second{0.0};
+};
+
+// Aggregate throughput: frames per second of wall time from the first submitted frame to the last finished one.
+struct FleetStats {
+    std::vector<FleetStreamStats> streams{};
+    std::uint64_t processed_frames{0U};
+    std::uint64_t failed_frames{0U};
+    std::uint64_t busy_us{0U};
+    std::uint64_t wall_us{0U};
+    std::uint64_t steals{0U};
+    double frames_per_second{0.0};
+};
+
+// One UltrasoundProcessor per stream, all sharing one geometry plan (and LOOKUP table), driven by a shared
+// work-stealing pool of config.worker_threads threads. Each stream runs at most one task at a time and a task
+// handles one frame, so a stream's frames and vehicle states are applied in submission order while frames of
+// different streams run on whichever threads are free. Streams process frame by frame, without parallel pair
+// passes, since the pool is already shared by the streams.
+class ProcessorFleet {
+  public:
+    explicit ProcessorFleet(ProcessorConfig config,
+                            std::shared_ptr<const GeometryPlan> plan = nullptr,
+                            std::shared_ptr<const IntersectionLut> lut = nullptr);
+    // Finishes every submitted frame first.
+    ~ProcessorFleet();
+    ProcessorFleet(const ProcessorFleet&) = delete;
+    ProcessorFleet& operator=(const ProcessorFleet&) = delete;
+
+    Status add_stream(std::uint32_t stream_id);
+    // Queued behind the stream's earlier submissions; timestamps must increase per stream.
+    Status push_vehicle_state(std::uint32_t stream_id, const VehicleState& state);
+    Status submit_frame(std::uint32_t stream_id, FrameInput frame);
+    // Blocks until every submitted frame has been processed.
+    void wait_idle();
+    // Moves the stream's finished frames, in submission order, into `results`.
+    Status take_results(std::uint32_t stream_id, std::vector<FleetFrameResult>& results);
+
+    FleetStats stats() const;
+    const std::shared_ptr<const GeometryPlan>& geometry_plan() const;
+    const std::shared_ptr<const IntersectionLut>& intersection_lut() const;
+    // Null for unknown streams. Only safe to use while the fleet is idle.
+    const UltrasoundProcessor* processor(std::uint32_t stream_id) const;
+
+  private:
+    struct Stream;
+
+    Stream* find_stream(std::uint32_t stream_id) const;
+    // Queues a task for `stream` unless one is already queued or running.
+    void schedule(Stream& stream);
+    void run_stream(Stream& stream);
+
+    ProcessorConfig config_{};
+    std::shared_ptr<const GeometryPlan> plan_{};
+    std::shared_ptr<const IntersectionLut> lut_{};
+    mutable std::mutex streams_mutex_{};
+    std::unordered_map<std::uint32_t, std::unique_ptr<Stream>> streams_;
+    mutable std::mutex timing_mutex_{};
+    std::optional<std::chrono::steady_clock::time_point> first_submit_{};
+    std::chrono::steady_clock::time_point last_finish_{};
+    // Declared last: destroyed first, so running tasks finish while the streams still exist.
+    WorkStealingPool pool_;
+};
+
+}  // namespace ultrasound
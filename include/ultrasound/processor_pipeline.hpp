@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "ultrasound/diagnostics.hpp"
+#include "ultrasound/error.hpp"
+#include "ultrasound/processor.hpp"
+#include "ultrasound/spsc_ring.hpp"
+#include "ultrasound/types.hpp"
+
+namespace ultrasound {
+
+// Called on the publish thread for every submitted frame, in sequence order; `output` is meaningful only when
+// `status` is ok and is reused once the callback returns.
+using PipelineFrameCallback = std::function<void(std::uint64_t sequence, const Status& status, const FrameOutput& output)>;
+
+struct PipelineStageStats {
+    // Items the stage has handed on: frames and queued vehicle states alike.
+    std::uint64_t items{0U};
+    // Times the stage found the next ring full and had to wait for the downstream stage.
+    std::uint64_t stalls{0U};
+    // Items waiting in the stage's input ring, now and at most.
+    std::size_t queue_depth{0U};
+    std::size_t max_queue_depth{0U};
+};
+
+struct PipelineStats {
+    // Frames submitted and frames whose callback has returned.
+    std::uint64_t submitted_frames{0U};
+    std::uint64_t published_frames{0U};
+    // Times submit() or push_vehicle_state() waited for a free slot or for room in the admit ring.
+    std::uint64_t submit_stalls{0U};
+    PipelineStageStats admit{};
+    PipelineStageStats postprocess{};
+    PipelineStageStats publish{};
+};
+
+// Runs an UltrasoundProcessor's frame stages on three threads linked by bounded SPSC rings: admission,
+// post-processing, and publishing to the callback. Frames carry the sequence number submit() returns and reach
+// the callback in that order, dropped ones included, with results identical to process_frame(). A slow
+// callback only holds up ingestion once every ring is full.
+//
+// Admission covers validation, pose interpolation, signal-way filtering (convert_frame) and the frame-reuse
+// check. Filtering needs the pose admission just interpolated, and the reuse check needs the filtered ways while
+// it updates the processor's previous-frame state, which must happen in frame order before post-processing
+// starts on that frame. Filtering is a cheap linear pass, so a stage of its own would add a ring hop and a
+// thread to every frame without taking work off the post-processing bottleneck.
+//
+// submit() and push_vehicle_state() must be called from one thread. The processor must not be used directly
+// until stop(), which folds the stage counters into its diagnostics, except for offer_vehicle_state() from one
+// other thread: the admit stage takes those states in ahead of each frame.
+class ProcessorPipeline {
+  public:
+    ProcessorPipeline(UltrasoundProcessor& processor, PipelineFrameCallback on_frame, std::size_t queue_capacity = 16U);
+    // Calls stop().
+    ~ProcessorPipeline();
+    ProcessorPipeline(const ProcessorPipeline&) = delete;
+    ProcessorPipeline& operator=(const ProcessorPipeline&) = delete;
+
+    // Queued in order with the frames; timestamps must increase.
+    Status push_vehicle_state(const VehicleState& state);
+    // Returns the frame's sequence number, starting at 0.
+    std::uint64_t submit(FrameInput frame);
+    // Blocks until every submitted frame has been published.
+    void flush();
+    // Flushes, then stops and joins the stage threads. Idempotent.
+    void stop();
+
+    PipelineStats stats() const;
+
+  private:
+    // A queued vehicle state or frame. Slots circulate from the submitter through the stages and back, so their
+    // buffers are reused.
+    struct Item {
+        bool is_frame{false};
+        std::uint64_t sequence{0U};
+        VehicleState state{};
+        FrameInput input{};
+        FrameOutput output{};
+        StageTimingUs timing{};
+        Status status{};
+        bool reuse{false};
+    };
+    struct StageCounters {
+        std::atomic<std::uint64_t> items{0U};
+        std::atomic<std::uint64_t> stalls{0U};
+        std::atomic<std::size_t> max_queue_depth{0U};
+    };
+
+    // Submitter side: takes a free slot and queues it for the admit stage, waiting (and counting a submit stall)
+    // whenever either is unavailable.
+    Item* acquire_slot();
+    void enqueue(Item* item);
+    // Pops the next item for a stage (null once stopping), recording the queue depth it saw.
+    static Item* next_item(SpscRing<Item*>& in, StageCounters& counters);
+    // Hands `item` to the next stage, waiting (and counting a stall) while that ring is full.
+    static void forward(Item* item, SpscRing<Item*>& out, StageCounters& counters);
+    void run_admit();
+    void run_postprocess();
+    void run_publish();
+
+    UltrasoundProcessor& processor_;
+    PipelineFrameCallback on_frame_;
+    std::vector<Item> slots_;
+    // Slot flow: free -> admit -> postprocess -> publish -> free.
+    SpscRing<Item*> free_;
+    SpscRing<Item*> to_admit_;
+    SpscRing<Item*> to_postprocess_;
+    SpscRing<Item*> to_publish_;
+    StageCounters admit_counters_{};
+    StageCounters postprocess_counters_{};
+    StageCounters publish_counters_{};
+    // Stage-local counters, folded into the processor by stop(); each is touched by its stage thread only.
+    Diagnostics postprocess_diagnostics_{};
+    Diagnostics publish_diagnostics_{};
+    // Submitter-side state; submitted_ is also read by stats().
+    std::atomic<std::uint64_t> submitted_{0U};
+    std::uint64_t last_state_us_{0U};
+    bool has_state_{false};
+    std::atomic<std::uint64_t> submit_stalls_{0U};
+    std::atomic<std::uint64_t> published_{0U};
+    bool stopped_{false};
+    std::thread admit_thread_{};
+    std::thread postprocess_thread_{};
+    std::thread publish_thread_{};
+};
+
+}  // namespace ultrasound
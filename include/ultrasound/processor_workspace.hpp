@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ultrasound/clustering.hpp"
+#include "ultrasound/diagnostics.hpp"
+#include "ultrasound/ellipse_intersection.hpp"
+#include "ultrasound/ellipse_kernel.hpp"
+#include "ultrasound/pair_cache.hpp"
+#include "ultrasound/pair_candidates.hpp"
+#include "ultrasound/spatial_index.hpp"
+
+namespace ultrasound {
+
+// Scratch of one pair evaluation. `sampled_model` names the model whose samples `samples` holds, so pairs sharing
+// their first model sample it once.
+struct PairScratch {
+    EllipseSampleBlock samples{};
+    std::array<double, kEllipseSamples + 1U> implicit_values{};
+    std::vector<std::array<double, 2U>> roots{};
+    std::size_t sampled_model{0U};
+};
+
+// State of a background thread evaluating pairs of the current frame; its counters are folded back per pass.
+struct PairWorker {
+    PairScratch scratch{};
+    Diagnostics diagnostics{};
+};
+
+// Per-processor scratch. Buffers are cleared, never released, between frames, so once capacities have
+// grown to the largest frame seen, steady-state processing does not touch the allocator.
+struct ProcessorWorkspace {
+    std::vector<PreparedEllipse> ellipses{};
+    std::vector<ModelOrigin> ellipse_origins{};
+    std::vector<std::uint64_t> ellipse_keys{};
+    std::vector<PreparedEllipse> fov_models{};
+    std::vector<ModelOrigin> fov_origins{};
+    std::vector<std::uint64_t> fov_keys{};
+    std::vector<std::uint64_t> frame_keys{};
+    std::vector<ModelPair> model_pairs{};
+    PairScratch pair{};
+    // Points of the pair being computed, and tolerance hits held back by the fused sampled collector until every
+    // pair's roots are pushed.
+    PairIntersections pair_result{};
+    // Parallel pair passes: per-pair results, the pairs left to compute, their chunk boundaries, and the
+    // background threads' scratch.
+    std::vector<PairIntersections> pair_results{};
+    std::vector<std::size_t> pending_pairs{};
+    std::vector<std::size_t> pair_chunks{};
+    std::vector<PairWorker> pair_workers{};
+    std::vector<std::array<double, 2U>> deferred_hits{};
+    std::vector<std::array<double, 2U>> fusion_candidates{};
+    UniqueDetectionGrid unique_detections{};
+    UniqueDetectionGrid unique_fused{};
+    MethodSupportGrid method_support{};
+    DetectionClusterer clusterer{};
+};
+
+}  // namespace ultrasound
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ultrasound {
+
+constexpr std::size_t kSignalWayGroups = 2U;
+constexpr std::size_t kSignalWaysPerGroup = 16U;
+
+// Range-independent geometry of one (group_id, signal_way_id) transmitter/receiver pair.
+struct SensorPairGeometry {
+    bool valid{false};
+    bool monostatic{false};
+    std::uint8_t tx{0U};
+    std::uint8_t rx{0U};
+    double center_x_m{0.0};
+    double center_y_m{0.0};
+    double half_baseline_m{0.0};
+    // Tracing direction: unit sum of both mounting directions (left unnormalized when they cancel).
+    double trace_dir_x{0.0};
+    double trace_dir_y{0.0};
+    // Monostatic FOV arc direction, anchored at the tx sensor.
+    double tx_x_m{0.0};
+    double tx_y_m{0.0};
+    double tx_dir_x{0.0};
+    double tx_dir_y{0.0};
+    double ellipse_theta_rad{0.0};
+    double fov_theta_rad{0.0};
+    // Bistatic center-ray intersection; usable when inside both sectors and range >= ray_min_range_m.
+    bool ray_in_sectors{false};
+    double ray_x_m{0.0};
+    double ray_y_m{0.0};
+    double ray_min_range_m{0.0};
+};
+
+struct SensorPairTable {
+    std::array<SensorPairGeometry, kSignalWayGroups * kSignalWaysPerGroup> entries{};
+};
+
+inline const SensorPairGeometry* find_sensor_pair(const SensorPairTable& table,
+                                                  std::uint8_t group_id,
+                                                  std::uint8_t signal_way_id) {
+    if (group_id >= kSignalWayGroups || signal_way_id >= kSignalWaysPerGroup) {
+        return nullptr;
+    }
+    const auto& entry = table.entries[group_id * kSignalWaysPerGroup + signal_way_id];
+    return entry.valid ? &entry : nullptr;
+}
+
+}  // namespace ultrasound
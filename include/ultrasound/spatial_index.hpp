@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ultrasound {
+
+// Uniform-grid hash of sequentially numbered points. Cells are `cell_size_m` wide (plus a rounding margin),
+// so every point within `cell_size_m` of a query lies in the query's 3x3 cell neighbourhood.
+class SpatialHashGrid {
+  public:
+    explicit SpatialHashGrid(double cell_size_m);
+
+    // Drops all points; keeps the slot capacity for reuse.
+    void clear(std::size_t expected_points = 0U);
+    // `index` must equal the number of points inserted since the last clear().
+    void insert(const std::array<double, 2U>& p, std::int32_t index);
+
+    // Calls visit(index) for every point in the 3x3 neighbourhood of `p` until it returns true.
+    template <typename Visitor>
+    bool visit_neighbourhood(const std::array<double, 2U>& p, Visitor&& visit) const {
+        const std::int64_t cx = cell_of(p[0]);
+        const std::int64_t cy = cell_of(p[1]);
+        for (std::int64_t ix = cx - 1; ix <= cx + 1; ++ix) {
+            for (std::int64_t iy = cy - 1; iy <= cy + 1; ++iy) {
+                const auto& slot = slots_[find_slot(pack_cell(ix, iy))];
+                for (std::int32_t k = slot.head; k >= 0; k = next_[static_cast<std::size_t>(k)]) {
+                    if (visit(k)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+  private:
+    struct Slot {
+        std::int64_t key{0};
+        std::int32_t head{-1};
+    };
+
+    static std::int64_t pack_cell(std::int64_t ix, std::int64_t iy);
+    std::int64_t cell_of(double v) const;
+    std::size_t find_slot(std::int64_t key) const;
+    void rehash(std::size_t capacity);
+
+    double inv_cell_{0.0};
+    std::vector<Slot> slots_{};
+    std::vector<std::int32_t> next_{};
+    std::size_t used_slots_{0U};
+};
+
+// Insert-or-reject index over a detection list. A candidate is appended only when no stored detection lies
+// within `min_separation_m`, matching a linear-scan dedupe in both result and append order.
+class UniqueDetectionGrid {
+  public:
+    explicit UniqueDetectionGrid(double min_separation_m = 0.08);
+
+    // Binds the grid to `detections` and indexes the points it already holds. While attached, the list
+    // must only grow through push().
+    void attach(std::vector<std::array<double, 2U>>& detections);
+    bool push(const std::array<double, 2U>& candidate);
+
+  private:
+    double min_sep_sq_{0.0};
+    SpatialHashGrid grid_;
+    std::vector<std::array<double, 2U>>* detections_{nullptr};
+};
+
+// Shared neighbourhood index over the detections of several methods. Each entry carries its method bit,
+// so one lookup answers which methods have a detection within `radius_m` of a candidate.
+class MethodSupportGrid {
+  public:
+    explicit MethodSupportGrid(double radius_m = 0.55);
+
+    void clear(std::size_t expected_points = 0U);
+    void insert(const std::array<double, 2U>& p, std::uint8_t method_bit);
+    void insert_all(const std::vector<std::array<double, 2U>>& points, std::uint8_t method_bit);
+    // OR of the method bits within `radius_m`; stops early once every bit in `all_methods` is present.
+    std::uint8_t support_mask(const std::array<double, 2U>& candidate, std::uint8_t all_methods) const;
+
+  private:
+    double radius_sq_{0.0};
+    SpatialHashGrid grid_;
+    std::vector<std::array<double, 2U>> points_{};
+    std::vector<std::uint8_t> methods_{};
+};
+
+}  // namespace ultrasound
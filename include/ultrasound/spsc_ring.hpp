@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ultrasound {
+
+// Bounded single-producer/single-consumer queue. try_push() and try_pop() are wait-free: each touches only its
+// own index plus an acquire load of the other side's, and fails instead of waiting when the ring is full or
+// empty. The wait_* helpers block (through std::atomic::wait) until the other side makes progress.
+template <typename T>
+class SpscRing {
+  public:
+    // Capacity is rounded up to a power of two.
+    explicit SpscRing(std::size_t capacity)
+        : slots_(std::bit_ceil(std::max<std::size_t>(capacity, 2U))),
+          mask_(slots_.size() - 1U) {}
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const {
+        return slots_.size();
+    }
+
+    // Items currently queued; exact on either side's thread, a snapshot elsewhere.
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    // Producer side.
+    bool try_push(T value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - producer_head_ == slots_.size()) {
+            producer_head_ = head_.load(std::memory_order_acquire);
+            if (tail - producer_head_ == slots_.size()) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1U, std::memory_order_release);
+        tail_.notify_one();
+        return true;
+    }
+
+    // Consumer side.
+    bool try_pop(T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == consumer_tail_) {
+            consumer_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == consumer_tail_) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1U, std::memory_order_release);
+        head_.notify_one();
+        return true;
+    }
+
+    // Producer side: blocks while the ring is full.
+    void wait_for_space() const {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        for (std::size_t head = head_.load(std::memory_order_acquire); tail - head == slots_.size();
+             head = head_.load(std::memory_order_acquire)) {
+            head_.wait(head, std::memory_order_acquire);
+        }
+    }
+
+    // Consumer side: blocks while the ring is empty.
+    void wait_for_item() const {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        for (std::size_t tail = tail_.load(std::memory_order_acquire); tail == head;
+             tail = tail_.load(std::memory_order_acquire)) {
+            tail_.wait(tail, std::memory_order_acquire);
+        }
+    }
+
+  private:
+    static constexpr std::size_t kCacheLine = 64U;
+
+    std::vector<T> slots_;
+    std::size_t mask_{0U};
+    // Consumer index and the consumer's last view of tail_, then the producer's pair, on separate cache lines.
+    alignas(kCacheLine) std::atomic<std::size_t> head_{0U};
+    std::size_t consumer_tail_{0U};
+    alignas(kCacheLine) std::atomic<std::size_t> tail_{0U};
+    std::size_t producer_head_{0U};
+};
+
+}  // namespace ultrasound
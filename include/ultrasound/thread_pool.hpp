@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ultrasound {
+
+// Fixed set of worker threads running index-parallel loops. The calling thread takes part in every loop, so a
+// pool with `background_threads` workers runs loops on background_threads + 1 threads. Indices are handed out
+// one at a time, which balances uneven per-index cost. Loops from different callers are serialized.
+class ThreadPool {
+  public:
+    explicit ThreadPool(std::size_t background_threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads taking part in a loop; valid slots passed to the loop body are [0, concurrency()).
+    std::size_t concurrency() const {
+        return threads_.size() + 1U;
+    }
+
+    // Calls body(index, slot) for every index in [0, count) and returns once all calls have finished. `slot`
+    // identifies the executing thread (0 is the caller) for per-thread scratch; the body must not throw.
+    void parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body);
+
+  private:
+    void worker_loop(std::size_t slot);
+    void drain(std::size_t slot);
+
+    std::vector<std::thread> threads_{};
+    std::mutex loop_mutex_{};
+    std::mutex mutex_{};
+    std::condition_variable start_cv_{};
+    std::condition_variable done_cv_{};
+    const std::function<void(std::size_t, std::size_t)>* body_{nullptr};
+    std::size_t count_{0U};
+    std::atomic<std::size_t> next_{0U};
+    std::size_t busy_workers_{0U};
+    std::uint64_t generation_{0U};
+    bool stop_{false};
+};
+
+// Background threads for a requested thread count: `threads` - 1, or hardware concurrency - 1 when 0.
+std::size_t background_threads_for(std::size_t threads);
+
+}  // namespace ultrasound
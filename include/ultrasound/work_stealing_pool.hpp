@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ultrasound {
+
+// Task pool with one deque per thread. A thread runs its own tasks newest first and, when it has none, steals
+// the oldest task of another thread, so independent task chains spread over idle threads. Tasks submitted from a
+// pool thread go to that thread's deque; others are dealt to the deques in turn.
+class WorkStealingPool {
+  public:
+    using Task = std::function<void()>;
+
+    // `threads` workers; 0 uses every hardware thread.
+    explicit WorkStealingPool(std::size_t threads);
+    // Runs every submitted task before joining the threads.
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::size_t thread_count() const {
+        return threads_.size();
+    }
+
+    // Tasks must not throw.
+    void submit(Task task);
+    // Returns once every task submitted so far, and every task those submitted, has finished.
+    void wait_idle();
+    // Tasks taken from another thread's deque since construction.
+    std::uint64_t steals() const {
+        return steals_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Worker {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+
+    bool take_task(std::size_t slot, Task& task);
+    void worker_loop(std::size_t slot);
+
+    std::vector<std::unique_ptr<Worker>> workers_{};
+    std::vector<std::thread> threads_{};
+    std::mutex mutex_{};
+    std::condition_variable work_cv_{};
+    std::condition_variable idle_cv_{};
+    // Guarded by mutex_: tasks sitting in a deque, and tasks submitted but not yet finished.
+    std::size_t queued_{0U};
+    std::size_t unfinished_{0U};
+    bool stop_{false};
+    std::atomic<std::size_t> next_worker_{0U};
+    std::atomic<std::uint64_t> steals_{0U};
+};
+
+}  // namespace ultrasound
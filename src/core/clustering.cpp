@@ -0,0 +1,85 @@
+#include "ultrasound/clustering.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ultrasound {
+
+std::int32_t DetectionClusterer::find_root(std::int32_t i) {
+    while (parent_[static_cast<std::size_t>(i)] != i) {
+        auto& p = parent_[static_cast<std::size_t>(i)];
+        p = parent_[static_cast<std::size_t>(p)];
+        i = p;
+    }
+    return i;
+}
+
+void DetectionClusterer::cluster(const std::vector<std::array<double, 2U>>& in, double radius_m,
+                                 std::vector<std::array<double, 2U>>& out) {
+    out.clear();
+    if (in.empty()) {
+        return;
+    }
+
+    const double radius_sq = radius_m * radius_m;
+    // Any positive cell works for a zero radius (coincident points share a cell); a NaN radius links nothing.
+    double cell = std::abs(radius_m);
+    if (!(cell > 0.0) || !std::isfinite(cell)) {
+        cell = 1.0;
+    }
+    if (cell != cell_size_m_) {
+        grid_ = SpatialHashGrid(cell);
+        cell_size_m_ = cell;
+    }
+
+    const std::size_t n = in.size();
+    grid_.clear(n);
+    parent_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto self = static_cast<std::int32_t>(i);
+        parent_[i] = self;
+        grid_.visit_neighbourhood(in[i], [&](std::int32_t j) {
+            const double dx = in[i][0] - in[static_cast<std::size_t>(j)][0];
+            const double dy = in[i][1] - in[static_cast<std::size_t>(j)][1];
+            if ((dx * dx + dy * dy) <= radius_sq) {
+                // Keep the lowest index as root so roots enumerate clusters in first-member order.
+                const std::int32_t a = find_root(self);
+                const std::int32_t b = find_root(j);
+                if (a < b) {
+                    parent_[static_cast<std::size_t>(b)] = a;
+                } else if (b < a) {
+                    parent_[static_cast<std::size_t>(a)] = b;
+                }
+            }
+            return false;
+        });
+        grid_.insert(in[i], self);
+    }
+
+    label_.resize(n);
+    sum_x_.clear();
+    sum_y_.clear();
+    count_.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto root = static_cast<std::size_t>(find_root(static_cast<std::int32_t>(i)));
+        if (root == i) {
+            label_[i] = static_cast<std::int32_t>(count_.size());
+            sum_x_.push_back(0.0);
+            sum_y_.push_back(0.0);
+            count_.push_back(0.0);
+        }
+        const auto c = static_cast<std::size_t>(label_[root]);
+        sum_x_[c] += in[i][0];
+        sum_y_[c] += in[i][1];
+        count_[c] += 1.0;
+    }
+
+    out.reserve(count_.size());
+    for (std::size_t c = 0; c < count_.size(); ++c) {
+        out.push_back({sum_x_[c] / count_[c], sum_y_[c] / count_[c]});
+    }
+}
+
+}  // namespace ultrasound
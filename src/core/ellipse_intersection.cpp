@@ -0,0 +1,747 @@
+#include "ultrasound/ellipse_intersection.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+#include "ultrasound/ellipse_kernel.hpp"
+
+namespace ultrasound {
+namespace {
+
+constexpr double kTwoPi = 2.0 * std::numbers::pi_v<double>;
+
+double sqr(double value) {
+    return value * value;
+}
+
+// q(t) = k0 + k1 cos t + k2 sin t + k3 cos 2t + k4 sin 2t
+struct TrigQuadratic {
+    double k0{0.0};
+    double k1{0.0};
+    double k2{0.0};
+    double k3{0.0};
+    double k4{0.0};
+};
+
+double evaluate(const TrigQuadratic& q, double t) {
+    const double c = std::cos(t);
+    const double s = std::sin(t);
+    return q.k0 + q.k1 * c + q.k2 * s + q.k3 * (c * c - s * s) + q.k4 * (2.0 * c * s);
+}
+
+TrigQuadratic derivative(const TrigQuadratic& q) {
+    return {0.0, q.k2, -q.k1, 2.0 * q.k4, -2.0 * q.k3};
+}
+
+// Implicit equation of `b` evaluated along the parametric form of `a`, expanded to double angles.
+TrigQuadratic implicit_along(const EllipseModel& a, const EllipseModel& b) {
+    const double cb = std::cos(b.theta);
+    const double sb = std::sin(b.theta);
+    const double dx = a.cx - b.cx;
+    const double dy = a.cy - b.cy;
+    const double u0 = dx * cb + dy * sb;
+    const double v0 = -dx * sb + dy * cb;
+
+    const double phi = a.theta - b.theta;
+    const double cp = std::cos(phi);
+    const double sp = std::sin(phi);
+    const double u1 = a.axis_a * cp;
+    const double u2 = -a.axis_b * sp;
+    const double v1 = a.axis_a * sp;
+    const double v2 = a.axis_b * cp;
+
+    const double inv_a2 = 1.0 / std::max(sqr(b.axis_a), 1.0e-9);
+    const double inv_b2 = 1.0 / std::max(sqr(b.axis_b), 1.0e-9);
+
+    TrigQuadratic q;
+    q.k0 = (sqr(u0) + 0.5 * (sqr(u1) + sqr(u2))) * inv_a2 + (sqr(v0) + 0.5 * (sqr(v1) + sqr(v2))) * inv_b2 - 1.0;
+    q.k1 = 2.0 * u0 * u1 * inv_a2 + 2.0 * v0 * v1 * inv_b2;
+    q.k2 = 2.0 * u0 * u2 * inv_a2 + 2.0 * v0 * v2 * inv_b2;
+    q.k3 = 0.5 * (sqr(u1) - sqr(u2)) * inv_a2 + 0.5 * (sqr(v1) - sqr(v2)) * inv_b2;
+    q.k4 = u1 * u2 * inv_a2 + v1 * v2 * inv_b2;
+    return q;
+}
+
+// Implicit equation of the circle `b` along `a`: |a(t) - c_b|^2 / r^2 - 1 needs no rotation into b's frame,
+// and the parameter axes of `a` are orthogonal, so the sin 2t term vanishes.
+TrigQuadratic circle_implicit_along(const EllipseModel& a, const EllipseModel& b) {
+    const double ca = std::cos(a.theta);
+    const double sa = std::sin(a.theta);
+    const double wx = a.cx - b.cx;
+    const double wy = a.cy - b.cy;
+    const double inv_r2 = 1.0 / std::max(sqr(b.axis_a), 1.0e-9);
+
+    TrigQuadratic q;
+    q.k0 = (sqr(wx) + sqr(wy) + 0.5 * (sqr(a.axis_a) + sqr(a.axis_b))) * inv_r2 - 1.0;
+    q.k1 = 2.0 * a.axis_a * (wx * ca + wy * sa) * inv_r2;
+    q.k2 = 2.0 * a.axis_b * (wy * ca - wx * sa) * inv_r2;
+    q.k3 = 0.5 * (sqr(a.axis_a) - sqr(a.axis_b)) * inv_r2;
+    return q;
+}
+
+// Implicit equation of `b` along the circle `a`, whose parameter is measured from b's major axis (a.theta must
+// equal b.theta). The sin 2t term vanishes here as well.
+TrigQuadratic implicit_along_circle(const EllipseModel& a, const EllipseModel& b) {
+    const double cb = std::cos(b.theta);
+    const double sb = std::sin(b.theta);
+    const double dx = a.cx - b.cx;
+    const double dy = a.cy - b.cy;
+    const double u0 = dx * cb + dy * sb;
+    const double v0 = -dx * sb + dy * cb;
+    const double r = a.axis_a;
+
+    const double inv_a2 = 1.0 / std::max(sqr(b.axis_a), 1.0e-9);
+    const double inv_b2 = 1.0 / std::max(sqr(b.axis_b), 1.0e-9);
+
+    TrigQuadratic q;
+    q.k0 = (sqr(u0) + 0.5 * sqr(r)) * inv_a2 + (sqr(v0) + 0.5 * sqr(r)) * inv_b2 - 1.0;
+    q.k1 = 2.0 * u0 * r * inv_a2;
+    q.k2 = 2.0 * v0 * r * inv_b2;
+    q.k3 = 0.5 * sqr(r) * (inv_a2 - inv_b2);
+    return q;
+}
+
+double evaluate_polynomial(const std::array<double, 5U>& c, std::size_t degree, double x) {
+    double v = c[degree];
+    for (std::size_t i = degree; i-- > 0U;) {
+        v = v * x + c[i];
+    }
+    return v;
+}
+
+// Real roots of c[0] + c[1] x + ... + c[degree] x^degree in ascending order. Roots are isolated
+// between the critical points of the polynomial and refined by bisection, which stays well behaved
+// where the quartic/cubic radical formulas lose precision.
+std::size_t polynomial_real_roots(const std::array<double, 5U>& c, std::size_t degree, std::array<double, 4U>& roots) {
+    double scale = 0.0;
+    for (std::size_t i = 0; i <= degree; ++i) {
+        scale = std::max(scale, std::fabs(c[i]));
+    }
+    if (scale <= 0.0) {
+        return 0U;
+    }
+    while (degree > 0U && std::fabs(c[degree]) <= 1.0e-13 * scale) {
+        --degree;
+    }
+    if (degree == 0U) {
+        return 0U;
+    }
+    if (degree == 1U) {
+        roots[0] = -c[0] / c[1];
+        return 1U;
+    }
+    if (degree == 2U) {
+        const double disc = sqr(c[1]) - 4.0 * c[2] * c[0];
+        if (disc < 0.0) {
+            return 0U;
+        }
+        const double q = -0.5 * (c[1] + std::copysign(std::sqrt(disc), c[1]));
+        if (q == 0.0) {
+            roots[0] = 0.0;
+            return 1U;
+        }
+        const double r0 = q / c[2];
+        const double r1 = c[0] / q;
+        roots[0] = std::min(r0, r1);
+        roots[1] = std::max(r0, r1);
+        return 2U;
+    }
+
+    std::array<double, 5U> dc{};
+    for (std::size_t i = 0; i < degree; ++i) {
+        dc[i] = static_cast<double>(i + 1U) * c[i + 1U];
+    }
+    std::array<double, 4U> critical{};
+    const std::size_t critical_count = polynomial_real_roots(dc, degree - 1U, critical);
+
+    double bound = 0.0;
+    for (std::size_t i = 0; i < degree; ++i) {
+        bound = std::max(bound, std::fabs(c[i] / c[degree]));
+    }
+    bound += 1.0;
+
+    std::array<double, 6U> breaks{};
+    std::size_t break_count = 0U;
+    breaks[break_count++] = -bound;
+    for (std::size_t i = 0; i < critical_count; ++i) {
+        breaks[break_count++] = std::clamp(critical[i], -bound, bound);
+    }
+    breaks[break_count++] = bound;
+
+    std::size_t count = 0U;
+    for (std::size_t i = 0; i + 1U < break_count && count < degree; ++i) {
+        double lo = breaks[i];
+        double hi = breaks[i + 1U];
+        double f_lo = evaluate_polynomial(c, degree, lo);
+        const double f_hi = evaluate_polynomial(c, degree, hi);
+        if (f_lo == 0.0) {
+            if (count == 0U || roots[count - 1U] != lo) {
+                roots[count++] = lo;
+            }
+            continue;
+        }
+        if ((f_lo < 0.0) == (f_hi < 0.0) || f_hi == 0.0) {
+            continue;
+        }
+        for (int it = 0; it < 128; ++it) {
+            const double mid = 0.5 * (lo + hi);
+            if (mid <= lo || mid >= hi) {
+                break;
+            }
+            const double f_mid = evaluate_polynomial(c, degree, mid);
+            if ((f_mid < 0.0) == (f_lo < 0.0)) {
+                lo = mid;
+                f_lo = f_mid;
+            } else {
+                hi = mid;
+            }
+        }
+        roots[count++] = 0.5 * (lo + hi);
+    }
+    return count;
+}
+
+// Roots of a trigonometric quadratic on [0, 2*pi), via the tangent half-angle substitution w = tan(t/2).
+// The parameter is shifted so that t = pi (w at infinity) sits where |q| is largest, keeping w bounded.
+std::size_t trig_roots(const TrigQuadratic& q, std::array<double, 4U>& roots) {
+    double shift = 0.0;
+    double best_lead = -1.0;
+    for (int m = 0; m < 8; ++m) {
+        const double candidate = static_cast<double>(m) * (0.25 * std::numbers::pi_v<double>);
+        const double lead = std::fabs(evaluate(q, candidate + std::numbers::pi_v<double>));
+        if (lead > best_lead) {
+            best_lead = lead;
+            shift = candidate;
+        }
+    }
+
+    const double c1 = std::cos(shift);
+    const double s1 = std::sin(shift);
+    const double c2 = std::cos(2.0 * shift);
+    const double s2 = std::sin(2.0 * shift);
+    const double k0 = q.k0;
+    const double k1 = q.k1 * c1 + q.k2 * s1;
+    const double k2 = q.k2 * c1 - q.k1 * s1;
+    const double k3 = q.k3 * c2 + q.k4 * s2;
+    const double k4 = q.k4 * c2 - q.k3 * s2;
+
+    const std::array<double, 5U> poly{
+        k0 + k1 + k3,
+        2.0 * k2 + 4.0 * k4,
+        2.0 * k0 - 6.0 * k3,
+        2.0 * k2 - 4.0 * k4,
+        k0 - k1 + k3,
+    };
+    std::array<double, 4U> w{};
+    const std::size_t count = polynomial_real_roots(poly, 4U, w);
+    for (std::size_t i = 0; i < count; ++i) {
+        double t = shift + 2.0 * std::atan(w[i]);
+        if (t < 0.0) {
+            t += kTwoPi;
+        }
+        if (t >= kTwoPi) {
+            t -= kTwoPi;
+        }
+        roots[i] = t;
+    }
+    std::sort(roots.begin(), roots.begin() + static_cast<std::ptrdiff_t>(count));
+    return count;
+}
+
+// Safeguarded Newton on a bracket [lo, hi] with q(lo) and q(hi) of opposite sign.
+double refine_trig_root(const TrigQuadratic& q, const TrigQuadratic& dq, double lo, double hi, double f_lo) {
+    double t = 0.5 * (lo + hi);
+    for (int it = 0; it < 64; ++it) {
+        const double f = evaluate(q, t);
+        if (f == 0.0) {
+            return t;
+        }
+        if ((f < 0.0) == (f_lo < 0.0)) {
+            lo = t;
+        } else {
+            hi = t;
+        }
+        const double df = evaluate(dq, t);
+        double next = (df != 0.0) ? t - f / df : lo;
+        if (!(next > lo && next < hi)) {
+            next = 0.5 * (lo + hi);
+        }
+        if (std::fabs(next - t) <= 1.0e-13) {
+            return next;
+        }
+        t = next;
+    }
+    return t;
+}
+
+// Roots of q, the implicit equation of the other conic along `a`, as points on `a`.
+bool solve_along(const EllipseModel& a, const TrigQuadratic& q, EllipsePairSolution& solution) {
+    solution = EllipsePairSolution{};
+
+    const double amplitude = std::fabs(q.k1) + std::fabs(q.k2) + std::fabs(q.k3) + std::fabs(q.k4);
+    if (amplitude <= 1.0e-9 * std::max(1.0, std::fabs(q.k0))) {
+        return false;
+    }
+
+    // The extrema of q split the parameter circle into monotone arcs, each holding at most one root.
+    const TrigQuadratic dq = derivative(q);
+    std::array<double, 4U> extrema{};
+    const std::size_t extrema_count = trig_roots(dq, extrema);
+    if (extrema_count < 2U) {
+        return false;
+    }
+
+    std::array<double, 4U> values{};
+    std::size_t closest = 0U;
+    for (std::size_t i = 0; i < extrema_count; ++i) {
+        values[i] = evaluate(q, extrema[i]);
+        if (std::fabs(values[i]) < std::fabs(values[closest])) {
+            closest = i;
+        }
+    }
+    solution.closest_point = ellipse_point(a, extrema[closest]);
+    solution.closest_error = std::fabs(values[closest]);
+
+    constexpr double kTangentTolerance = 1.0e-9;
+    for (std::size_t i = 0; i < extrema_count; ++i) {
+        const double lo = extrema[i];
+        const double f_lo = values[i];
+        const std::size_t next = (i + 1U) % extrema_count;
+        const double hi = (next == 0U) ? extrema[0] + kTwoPi : extrema[next];
+        const double f_hi = values[next];
+
+        if (std::fabs(f_lo) <= kTangentTolerance) {
+            if (solution.point_count == solution.points.size()) {
+                return false;
+            }
+            solution.points[solution.point_count++] = ellipse_point(a, lo);
+            continue;
+        }
+        if (std::fabs(f_hi) <= kTangentTolerance || (f_lo < 0.0) == (f_hi < 0.0)) {
+            continue;
+        }
+        if (solution.point_count == solution.points.size()) {
+            return false;
+        }
+        solution.points[solution.point_count++] = ellipse_point(a, refine_trig_root(q, dq, lo, hi, f_lo));
+    }
+    if (solution.point_count > 0U) {
+        solution.closest_point = solution.points[0];
+        solution.closest_error = 0.0;
+    }
+    return true;
+}
+
+}  // namespace
+
+[[gnu::noinline]] std::array<double, 2U> unit_circle_point(double param_t) {
+    return {std::cos(param_t), std::sin(param_t)};
+}
+
+std::array<double, 2U> ellipse_point(const EllipseModel& e, double param_t) {
+    const auto [ct, st] = unit_circle_point(param_t);
+    const double cp = std::cos(e.theta);
+    const double sp = std::sin(e.theta);
+
+    const double x_local = e.axis_a * ct;
+    const double y_local = e.axis_b * st;
+    return {e.cx + x_local * cp - y_local * sp, e.cy + x_local * sp + y_local * cp};
+}
+
+double ellipse_implicit_value(const EllipseModel& e, double x_m, double y_m) {
+    const double dx = x_m - e.cx;
+    const double dy = y_m - e.cy;
+    const double cp = std::cos(e.theta);
+    const double sp = std::sin(e.theta);
+    const double xr = dx * cp + dy * sp;
+    const double yr = -dx * sp + dy * cp;
+    return sqr(xr) / std::max(sqr(e.axis_a), 1.0e-9) + sqr(yr) / std::max(sqr(e.axis_b), 1.0e-9) - 1.0;
+}
+
+double ellipse_implicit_error(const EllipseModel& e, double x_m, double y_m) {
+    const double dx = x_m - e.cx;
+    const double dy = y_m - e.cy;
+    const double cp = std::cos(e.theta);
+    const double sp = std::sin(e.theta);
+    const double xr = dx * cp + dy * sp;
+    const double yr = -dx * sp + dy * cp;
+    const double v = sqr(xr) / std::max(sqr(e.axis_a), 1.0e-9) + sqr(yr) / std::max(sqr(e.axis_b), 1.0e-9);
+    return std::fabs(v - 1.0);
+}
+
+void sample_ellipse_intersections(const EllipseModel& a,
+                                  const EllipseModel& b,
+                                  std::vector<std::array<double, 2U>>& roots) {
+    const PreparedEllipse prepared_a = prepare_ellipse(a);
+    EllipseSampleBlock samples;
+    sample_ellipse(prepared_a, samples);
+    sample_ellipse_intersections(prepared_a, samples, prepare_ellipse(b), roots);
+}
+
+void sample_ellipse_intersections(const PreparedEllipse& a,
+                                  const EllipseSampleBlock& a_samples,
+                                  const PreparedEllipse& b,
+                                  std::vector<std::array<double, 2U>>& roots) {
+    std::array<double, kEllipseSamples + 1U> values;
+    ellipse_implicit_values(b, a_samples.x.data(), a_samples.y.data(), values.data(), values.size());
+    sample_ellipse_intersections(a, values, b, roots);
+}
+
+void sample_ellipse_intersections(const PreparedEllipse& a,
+                                  const std::array<double, kEllipseSamples + 1U>& values,
+                                  const PreparedEllipse& b,
+                                  std::vector<std::array<double, 2U>>& roots) {
+    double prev_t = 0.0;
+    double prev_v = values[0];
+    for (std::size_t s = 1; s <= kEllipseSamples; ++s) {
+        const double t = (static_cast<double>(s) / static_cast<double>(kEllipseSamples)) * kTwoPi;
+        const double v = values[s];
+
+        if ((prev_v <= 0.0 && v >= 0.0) || (prev_v >= 0.0 && v <= 0.0)) {
+            double lo = prev_t;
+            double hi = t;
+            for (int it = 0; it < 20; ++it) {
+                const double mid = 0.5 * (lo + hi);
+                const auto mid_p = ellipse_point(a, mid);
+                const double mid_v = ellipse_implicit_value(b, mid_p[0], mid_p[1]);
+                if ((prev_v <= 0.0 && mid_v >= 0.0) || (prev_v >= 0.0 && mid_v <= 0.0)) {
+                    hi = mid;
+                } else {
+                    lo = mid;
+                    prev_v = mid_v;
+                }
+            }
+            roots.push_back(ellipse_point(a, 0.5 * (lo + hi)));
+        }
+
+        prev_t = t;
+        prev_v = v;
+    }
+}
+
+namespace {
+
+constexpr std::size_t kCoarseSamples = 36U;
+constexpr std::size_t kCoarseStride = kEllipseSamples / kCoarseSamples;
+static_assert(kEllipseSamples % kCoarseSamples == 0U, "coarse samples must reuse the unit-circle table");
+constexpr double kParamTolerance = 1.0e-10;
+
+// Implicit value of `b` along `a` at parameter t, counting evaluations.
+struct PairEvaluator {
+    const PreparedEllipse& a;
+    const PreparedEllipse& b;
+    std::size_t evaluations{0U};
+
+    double operator()(double t) {
+        ++evaluations;
+        const auto p = ellipse_point(a, t);
+        return ellipse_implicit_value(b, p[0], p[1]);
+    }
+};
+
+// Brent's root finder on [lo, hi] with f(lo) and f(hi) of opposite sign.
+double brent_root(PairEvaluator& f, double lo, double hi, double f_lo, double f_hi) {
+    double a = lo;
+    double b = hi;
+    double fa = f_lo;
+    double fb = f_hi;
+    double c = a;
+    double fc = fa;
+    double d = b - a;
+    double e = d;
+    for (int it = 0; it < 64; ++it) {
+        if ((fb > 0.0) == (fc > 0.0)) {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+        if (std::fabs(fc) < std::fabs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+        const double tol = 2.0 * std::numeric_limits<double>::epsilon() * std::fabs(b) + 0.5 * kParamTolerance;
+        const double m = 0.5 * (c - b);
+        if (std::fabs(m) <= tol || fb == 0.0) {
+            return b;
+        }
+        if (std::fabs(e) >= tol && std::fabs(fa) > std::fabs(fb)) {
+            // Secant or inverse quadratic interpolation step.
+            const double s = fb / fa;
+            double p = 0.0;
+            double q = 0.0;
+            if (a == c) {
+                p = 2.0 * m * s;
+                q = 1.0 - s;
+            } else {
+                const double qa = fa / fc;
+                const double r = fb / fc;
+                p = s * (2.0 * m * qa * (qa - r) - (b - a) * (r - 1.0));
+                q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+            if (2.0 * p < std::min(3.0 * m * q - std::fabs(tol * q), std::fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = m;
+            }
+        } else {
+            d = m;
+            e = m;
+        }
+        a = b;
+        fa = fb;
+        b += (std::fabs(d) > tol) ? d : std::copysign(tol, m);
+        fb = f(b);
+    }
+    return b;
+}
+
+// Brent's minimiser (golden section with parabolic steps) of sign * f on [lo, hi].
+double brent_minimum(PairEvaluator& f, double sign, double lo, double hi, double& f_min) {
+    constexpr double kGolden = 0.3819660112501051;
+    double x = lo + kGolden * (hi - lo);
+    double w = x;
+    double v = x;
+    double fx = sign * f(x);
+    double fw = fx;
+    double fv = fx;
+    double d = 0.0;
+    double e = 0.0;
+    for (int it = 0; it < 64; ++it) {
+        const double mid = 0.5 * (lo + hi);
+        const double tol = std::sqrt(std::numeric_limits<double>::epsilon()) * std::fabs(x) + kParamTolerance / 3.0;
+        if (std::fabs(x - mid) <= 2.0 * tol - 0.5 * (hi - lo)) {
+            break;
+        }
+        bool golden = true;
+        if (std::fabs(e) > tol) {
+            double r = (x - w) * (fx - fv);
+            double q = (x - v) * (fx - fw);
+            double p = (x - v) * q - (x - w) * r;
+            q = 2.0 * (q - r);
+            if (q > 0.0) {
+                p = -p;
+            } else {
+                q = -q;
+            }
+            if (std::fabs(p) < std::fabs(0.5 * q * e) && p > q * (lo - x) && p < q * (hi - x)) {
+                e = d;
+                d = p / q;
+                const double u = x + d;
+                if (u - lo < 2.0 * tol || hi - u < 2.0 * tol) {
+                    d = (x < mid) ? tol : -tol;
+                }
+                golden = false;
+            }
+        }
+        if (golden) {
+            e = (x < mid) ? hi - x : lo - x;
+            d = kGolden * e;
+        }
+        const double u = (std::fabs(d) >= tol) ? x + d : x + std::copysign(tol, d);
+        const double fu = sign * f(u);
+        if (fu <= fx) {
+            (u < x ? hi : lo) = x;
+            v = w;
+            fv = fw;
+            w = x;
+            fw = fx;
+            x = u;
+            fx = fu;
+        } else {
+            (u < x ? lo : hi) = u;
+            if (fu <= fw || w == x) {
+                v = w;
+                fv = fw;
+                w = u;
+                fw = fu;
+            } else if (fu <= fv || v == x || v == w) {
+                v = u;
+                fv = fu;
+            }
+        }
+    }
+    f_min = fx;
+    return x;
+}
+
+bool push_root(const PreparedEllipse& a, double t, EllipsePairSolution& solution) {
+    if (solution.point_count == solution.points.size()) {
+        return false;
+    }
+    solution.points[solution.point_count++] = ellipse_point(a, t);
+    return true;
+}
+
+}  // namespace
+
+bool adaptive_ellipse_intersections(const PreparedEllipse& a,
+                                    const PreparedEllipse& b,
+                                    EllipsePairSolution& solution,
+                                    std::size_t* evaluations) {
+    solution = EllipsePairSolution{};
+    PairEvaluator f{a, b};
+
+    const auto& table = unit_circle_table();
+    std::array<double, kCoarseSamples + 1U> t{};
+    std::array<double, kCoarseSamples + 1U> v{};
+    double amplitude = 0.0;
+    for (std::size_t k = 0; k < kCoarseSamples; ++k) {
+        const std::size_t s = k * kCoarseStride;
+        const double x_local = a.model.axis_a * table.cos_t[s];
+        const double y_local = a.model.axis_b * table.sin_t[s];
+        t[k] = (static_cast<double>(s) / static_cast<double>(kEllipseSamples)) * kTwoPi;
+        v[k] = ellipse_implicit_value(b, a.model.cx + x_local * a.cos_theta - y_local * a.sin_theta,
+                                      a.model.cy + x_local * a.sin_theta + y_local * a.cos_theta);
+        amplitude = std::max(amplitude, std::fabs(v[k]));
+    }
+    f.evaluations += kCoarseSamples;
+    t[kCoarseSamples] = kTwoPi;
+    v[kCoarseSamples] = v[0];
+    if (amplitude <= 1.0e-9) {
+        // Coincident models: every point is a root.
+        if (evaluations != nullptr) {
+            *evaluations = f.evaluations;
+        }
+        return false;
+    }
+
+    std::size_t best = 0U;
+    for (std::size_t k = 1; k < kCoarseSamples; ++k) {
+        if (std::fabs(v[k]) < std::fabs(v[best])) {
+            best = k;
+        }
+    }
+    double best_t = t[best];
+    double best_err = std::fabs(v[best]);
+
+    const auto crosses = [&](std::size_t k) { return (v[k] < 0.0) != (v[k + 1U] < 0.0); };
+    bool ok = true;
+    for (std::size_t k = 0; k < kCoarseSamples && ok; ++k) {
+        if (v[k] == 0.0) {
+            ok = push_root(a, t[k], solution);
+            continue;
+        }
+        if (crosses(k)) {
+            if (v[k + 1U] != 0.0) {
+                ok = push_root(a, brent_root(f, t[k], t[k + 1U], v[k], v[k + 1U]), solution);
+            }
+            continue;
+        }
+
+        // A local minimum of |v| between two non-crossing intervals may hide a tangency or a close pair of roots
+        // that the coarse grid steps over: minimise |v| over both neighbouring intervals.
+        const std::size_t prev = (k == 0U) ? kCoarseSamples - 1U : k - 1U;
+        const std::size_t next = k + 1U;
+        if (crosses(prev) || std::fabs(v[k]) > std::fabs(v[prev]) || std::fabs(v[k]) > std::fabs(v[next]) ||
+            std::fabs(v[k]) == std::fabs(v[next])) {
+            continue;
+        }
+        const double sign = (v[k] > 0.0) ? 1.0 : -1.0;
+        const double lo = (k == 0U) ? t[prev] - kTwoPi : t[prev];
+        const double hi = t[next];
+        double f_min = 0.0;
+        const double t_min = brent_minimum(f, sign, lo, hi, f_min);
+        if (f_min < 0.0) {
+            const double v_min = sign * f_min;
+            ok = push_root(a, brent_root(f, lo, t_min, v[prev], v_min), solution) &&
+                 push_root(a, brent_root(f, t_min, hi, v_min, v[next]), solution);
+        } else if (f_min < best_err) {
+            best_err = f_min;
+            best_t = t_min;
+        }
+    }
+    if (evaluations != nullptr) {
+        *evaluations = f.evaluations;
+    }
+    if (!ok) {
+        return false;
+    }
+
+    if (solution.point_count > 0U) {
+        solution.closest_point = solution.points[0];
+        solution.closest_error = 0.0;
+    } else {
+        solution.closest_point = ellipse_point(a, best_t);
+        solution.closest_error = best_err;
+    }
+    return true;
+}
+
+bool solve_circle_circle(const EllipseModel& a, const EllipseModel& b, EllipsePairSolution& solution) {
+    solution = EllipsePairSolution{};
+
+    const double ra = std::fabs(a.axis_a);
+    const double rb = std::fabs(b.axis_a);
+    const double dx = b.cx - a.cx;
+    const double dy = b.cy - a.cy;
+    const double d = std::hypot(dx, dy);
+    if (d <= 1.0e-9 * std::max(1.0, ra + rb)) {
+        return false;
+    }
+    const double ux = dx / d;
+    const double uy = dy / d;
+
+    // The implicit value of `b` along `a` has exactly two extrema, the points of `a` nearest to and furthest
+    // from b's centre.
+    const double inv_r2 = 1.0 / std::max(sqr(rb), 1.0e-9);
+    const std::array<double, 2U> near_p{a.cx + ra * ux, a.cy + ra * uy};
+    const std::array<double, 2U> far_p{a.cx - ra * ux, a.cy - ra * uy};
+    const double near_v = sqr(d - ra) * inv_r2 - 1.0;
+    const double far_v = sqr(d + ra) * inv_r2 - 1.0;
+    const bool near_closest = std::fabs(near_v) <= std::fabs(far_v);
+    solution.closest_point = near_closest ? near_p : far_p;
+    solution.closest_error = std::fabs(near_closest ? near_v : far_v);
+
+    constexpr double kTangentTolerance = 1.0e-9;
+    if (solution.closest_error <= kTangentTolerance) {
+        solution.points[solution.point_count++] = solution.closest_point;
+    } else if ((near_v < 0.0) != (far_v < 0.0)) {
+        // Common chord: perpendicular to the centre line at distance l from a's centre, half-length h.
+        const double l = (sqr(d) + sqr(ra) - sqr(rb)) / (2.0 * d);
+        const double h = std::sqrt(std::max(sqr(ra) - sqr(l), 0.0));
+        solution.points[solution.point_count++] = {a.cx + l * ux - h * uy, a.cy + l * uy + h * ux};
+        solution.points[solution.point_count++] = {a.cx + l * ux + h * uy, a.cy + l * uy - h * ux};
+    }
+    if (solution.point_count > 0U) {
+        solution.closest_point = solution.points[0];
+        solution.closest_error = 0.0;
+    }
+    return true;
+}
+
+bool solve_ellipse_intersections(const EllipseModel& a, const EllipseModel& b, EllipsePairSolution& solution) {
+    const bool a_circle = a.axis_a == a.axis_b;
+    const bool b_circle = b.axis_a == b.axis_b;
+    if (a_circle && b_circle) {
+        return solve_circle_circle(a, b, solution);
+    }
+    if (b_circle) {
+        return solve_along(a, circle_implicit_along(a, b), solution);
+    }
+    if (a_circle) {
+        // A circle has no preferred axis; aligning its parameter with b's axes removes the relative rotation.
+        EllipseModel aligned = a;
+        aligned.theta = b.theta;
+        return solve_along(aligned, implicit_along_circle(aligned, b), solution);
+    }
+    return solve_along(a, implicit_along(a, b), solution);
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,154 @@
+#include "ultrasound/ellipse_kernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ULTRASOUND_KERNEL_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ULTRASOUND_KERNEL_SSE2 1
+#endif
+
+namespace ultrasound {
+
+PreparedEllipse prepare_ellipse(const EllipseModel& e) {
+    PreparedEllipse p;
+    p.model = e;
+    p.cos_theta = std::cos(e.theta);
+    p.sin_theta = std::sin(e.theta);
+    p.axis_a_sq = std::max(e.axis_a * e.axis_a, 1.0e-9);
+    p.axis_b_sq = std::max(e.axis_b * e.axis_b, 1.0e-9);
+    const double half_w = std::hypot(e.axis_a * p.cos_theta, e.axis_b * p.sin_theta);
+    const double half_h = std::hypot(e.axis_a * p.sin_theta, e.axis_b * p.cos_theta);
+    p.min_x_m = e.cx - half_w;
+    p.max_x_m = e.cx + half_w;
+    p.min_y_m = e.cy - half_h;
+    p.max_y_m = e.cy + half_h;
+    p.circle = e.axis_a == e.axis_b;
+    return p;
+}
+
+bool circle_implicit_range(const PreparedEllipse& a, const PreparedEllipse& b, double& lo, double& hi) {
+    if (!b.circle) {
+        return false;
+    }
+    const double bx = b.model.cx;
+    const double by = b.model.cy;
+    double near = 0.0;
+    double far = 0.0;
+    if (a.circle) {
+        const double d = std::hypot(a.model.cx - bx, a.model.cy - by);
+        const double r = std::fabs(a.model.axis_a);
+        near = std::fabs(d - r);
+        far = d + r;
+    } else {
+        near = std::hypot(std::max({a.min_x_m - bx, 0.0, bx - a.max_x_m}), std::max({a.min_y_m - by, 0.0, by - a.max_y_m}));
+        far = std::hypot(std::max(std::fabs(a.min_x_m - bx), std::fabs(a.max_x_m - bx)),
+                         std::max(std::fabs(a.min_y_m - by), std::fabs(a.max_y_m - by)));
+    }
+    constexpr double kRoundingMargin = 1.0e-9;
+    lo = near * near / b.axis_a_sq - 1.0;
+    hi = far * far / b.axis_a_sq - 1.0;
+    lo -= kRoundingMargin * (1.0 + std::fabs(lo));
+    hi += kRoundingMargin * (1.0 + std::fabs(hi));
+    return true;
+}
+
+const UnitCircleTable& unit_circle_table() {
+    static const UnitCircleTable table = [] {
+        UnitCircleTable t;
+        for (std::size_t s = 0; s <= kEllipseSamples; ++s) {
+            const double param =
+                (static_cast<double>(s) / static_cast<double>(kEllipseSamples)) * (2.0 * std::numbers::pi_v<double>);
+            const auto [c, sn] = unit_circle_point(param);
+            t.cos_t[s] = c;
+            t.sin_t[s] = sn;
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Both point forms keep ellipse_point()'s operation order so samples are bit-identical to it.
+void sample_ellipse(const PreparedEllipse& e, EllipseSampleBlock& out) {
+    const auto& table = unit_circle_table();
+    for (std::size_t s = 0; s <= kEllipseSamples; ++s) {
+        const double x_local = e.model.axis_a * table.cos_t[s];
+        const double y_local = e.model.axis_b * table.sin_t[s];
+        out.x[s] = e.model.cx + x_local * e.cos_theta - y_local * e.sin_theta;
+        out.y[s] = e.model.cy + x_local * e.sin_theta + y_local * e.cos_theta;
+    }
+}
+
+std::array<double, 2U> ellipse_point(const PreparedEllipse& e, double param_t) {
+    const auto [ct, st] = unit_circle_point(param_t);
+    const double x_local = e.model.axis_a * ct;
+    const double y_local = e.model.axis_b * st;
+    return {e.model.cx + x_local * e.cos_theta - y_local * e.sin_theta,
+            e.model.cy + x_local * e.sin_theta + y_local * e.cos_theta};
+}
+
+// Same operation order as the EllipseModel overload in ellipse_intersection.cpp: -dx * sp + dy * cp is
+// rewritten as dy * cp - dx * sp, which is exact.
+double ellipse_implicit_value(const PreparedEllipse& e, double x_m, double y_m) {
+    const double dx = x_m - e.model.cx;
+    const double dy = y_m - e.model.cy;
+    const double xr = dx * e.cos_theta + dy * e.sin_theta;
+    const double yr = dy * e.cos_theta - dx * e.sin_theta;
+    return (xr * xr / e.axis_a_sq + yr * yr / e.axis_b_sq) - 1.0;
+}
+
+void ellipse_implicit_values_scalar(const PreparedEllipse& e,
+                                    const double* x,
+                                    const double* y,
+                                    double* out,
+                                    std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = ellipse_implicit_value(e, x[i], y[i]);
+    }
+}
+
+// Separate multiplies and adds (no FMA) keep every lane rounding exactly like the scalar kernel.
+void ellipse_implicit_values(const PreparedEllipse& e, const double* x, const double* y, double* out, std::size_t count) {
+    std::size_t i = 0U;
+#if defined(ULTRASOUND_KERNEL_AVX2)
+    const __m256d cx = _mm256_set1_pd(e.model.cx);
+    const __m256d cy = _mm256_set1_pd(e.model.cy);
+    const __m256d cp = _mm256_set1_pd(e.cos_theta);
+    const __m256d sp = _mm256_set1_pd(e.sin_theta);
+    const __m256d a2 = _mm256_set1_pd(e.axis_a_sq);
+    const __m256d b2 = _mm256_set1_pd(e.axis_b_sq);
+    const __m256d one = _mm256_set1_pd(1.0);
+    for (; i + 4U <= count; i += 4U) {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), cx);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), cy);
+        const __m256d xr = _mm256_add_pd(_mm256_mul_pd(dx, cp), _mm256_mul_pd(dy, sp));
+        const __m256d yr = _mm256_sub_pd(_mm256_mul_pd(dy, cp), _mm256_mul_pd(dx, sp));
+        const __m256d v = _mm256_add_pd(_mm256_div_pd(_mm256_mul_pd(xr, xr), a2), _mm256_div_pd(_mm256_mul_pd(yr, yr), b2));
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(v, one));
+    }
+#elif defined(ULTRASOUND_KERNEL_SSE2)
+    const __m128d cx = _mm_set1_pd(e.model.cx);
+    const __m128d cy = _mm_set1_pd(e.model.cy);
+    const __m128d cp = _mm_set1_pd(e.cos_theta);
+    const __m128d sp = _mm_set1_pd(e.sin_theta);
+    const __m128d a2 = _mm_set1_pd(e.axis_a_sq);
+    const __m128d b2 = _mm_set1_pd(e.axis_b_sq);
+    const __m128d one = _mm_set1_pd(1.0);
+    for (; i + 2U <= count; i += 2U) {
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), cx);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), cy);
+        const __m128d xr = _mm_add_pd(_mm_mul_pd(dx, cp), _mm_mul_pd(dy, sp));
+        const __m128d yr = _mm_sub_pd(_mm_mul_pd(dy, cp), _mm_mul_pd(dx, sp));
+        const __m128d v = _mm_add_pd(_mm_div_pd(_mm_mul_pd(xr, xr), a2), _mm_div_pd(_mm_mul_pd(yr, yr), b2));
+        _mm_storeu_pd(out + i, _mm_sub_pd(v, one));
+    }
+#endif
+    ellipse_implicit_values_scalar(e, x + i, y + i, out + i, count - i);
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,462 @@
+#include "ultrasound/geometry_plan.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+namespace ultrasound {
+namespace {
+
+struct SensorPose {
+    double x_m{0.0};
+    double y_m{0.0};
+    double mounting_rad{0.0};
+    double fov_rad{100.0 * (std::numbers::pi_v<double> / 180.0)};
+};
+
+constexpr double kDegToRad = std::numbers::pi_v<double> / 180.0;
+
+constexpr std::array<SensorPose, 12U> kDefaultSensors{
+    SensorPose{3.238, 0.913, 87.0 * (std::numbers::pi_v<double> / 180.0), 60.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{3.6, 0.715, 38.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{3.804, 0.276, 7.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{3.804, -0.276, -4.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{3.6, -0.715, -28.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{3.238, -0.913, -87.0 * (std::numbers::pi_v<double> / 180.0), 45.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{-0.775, -0.822, -100.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{-0.956, -0.71, -165.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{-1.09, -0.25, -175.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{-1.09, 0.25, 173.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{-0.956, 0.71, 151.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
+    SensorPose{-0.775, 0.822, 99.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
+};
+
+constexpr std::array<std::array<double, 2U>, 12U> kDefaultContour{
+    std::array<double, 2U>{-0.775, 0.822}, std::array<double, 2U>{-0.956, 0.71}, std::array<double, 2U>{-1.09, 0.25},
+    std::array<double, 2U>{-1.09, -0.25}, std::array<double, 2U>{-0.956, -0.71}, std::array<double, 2U>{-0.775, -0.822},
+    std::array<double, 2U>{3.238, -0.913}, std::array<double, 2U>{3.6, -0.715}, std::array<double, 2U>{3.804, -0.276},
+    std::array<double, 2U>{3.804, 0.276}, std::array<double, 2U>{3.6, 0.715}, std::array<double, 2U>{3.238, 0.913},
+};
+
+double sqr(double value) {
+    return value * value;
+}
+
+bool map_signal_way_to_sensor_pair(std::uint8_t group_id, std::uint8_t signal_way_id, int& tx, int& rx) {
+    const int base = (group_id == 1U) ? 6 : 0;
+    if (group_id > 1U || signal_way_id > 15U) {
+        return false;
+    }
+
+    switch (signal_way_id) {
+        case 0:
+            tx = base + 0;
+            rx = base + 0;
+            return true;
+        case 1:
+            tx = base + 0;
+            rx = base + 1;
+            return true;
+        case 2:
+            tx = base + 1;
+            rx = base + 0;
+            return true;
+        case 3:
+            tx = base + 1;
+            rx = base + 1;
+            return true;
+        case 4:
+            tx = base + 1;
+            rx = base + 2;
+            return true;
+        case 5:
+            tx = base + 2;
+            rx = base + 1;
+            return true;
+        case 6:
+            tx = base + 2;
+            rx = base + 2;
+            return true;
+        case 7:
+            tx = base + 2;
+            rx = base + 3;
+            return true;
+        case 8:
+            tx = base + 3;
+            rx = base + 2;
+            return true;
+        case 9:
+            tx = base + 3;
+            rx = base + 3;
+            return true;
+        case 10:
+            tx = base + 3;
+            rx = base + 4;
+            return true;
+        case 11:
+            tx = base + 4;
+            rx = base + 3;
+            return true;
+        case 12:
+            tx = base + 4;
+            rx = base + 4;
+            return true;
+        case 13:
+            tx = base + 4;
+            rx = base + 5;
+            return true;
+        case 14:
+            tx = base + 5;
+            rx = base + 4;
+            return true;
+        case 15:
+            tx = base + 5;
+            rx = base + 5;
+            return true;
+        default:
+            return false;
+    }
+}
+
+double wrap_to_pi(double angle) {
+    while (angle > std::numbers::pi_v<double>) {
+        angle -= 2.0 * std::numbers::pi_v<double>;
+    }
+    while (angle < -std::numbers::pi_v<double>) {
+        angle += 2.0 * std::numbers::pi_v<double>;
+    }
+    return angle;
+}
+
+bool point_in_sensor_sector(const GeometryPlan& plan, std::size_t s, const std::array<double, 2U>& p) {
+    const double dx = p[0] - plan.sensor_x_m[s];
+    const double dy = p[1] - plan.sensor_y_m[s];
+    const double bearing = std::atan2(dy, dx);
+    const double delta = std::fabs(wrap_to_pi(bearing - plan.sensor_mounting_rad[s]));
+    return delta <= (0.5 * plan.sensor_fov_rad[s] + 1.0e-6);
+}
+
+double sensor_distance(const GeometryPlan& plan, std::size_t s, const std::array<double, 2U>& p) {
+    const double dx = p[0] - plan.sensor_x_m[s];
+    const double dy = p[1] - plan.sensor_y_m[s];
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+bool ray_intersection(const std::array<double, 2U>& p0,
+                      const std::array<double, 2U>& d0,
+                      const std::array<double, 2U>& p1,
+                      const std::array<double, 2U>& d1,
+                      std::array<double, 2U>& out) {
+    const double det = d0[0] * d1[1] - d0[1] * d1[0];
+    if (std::fabs(det) < 1.0e-6) {
+        return false;
+    }
+
+    const double px = p1[0] - p0[0];
+    const double py = p1[1] - p0[1];
+    const double t = (px * d1[1] - py * d1[0]) / det;
+    const double u = (px * d0[1] - py * d0[0]) / det;
+    if (t < 0.0 || u < 0.0) {
+        return false;
+    }
+
+    out = {p0[0] + t * d0[0], p0[1] + t * d0[1]};
+    return true;
+}
+
+void add_sensor(GeometryPlan& plan, const SensorPose& s) {
+    plan.sensor_x_m.push_back(s.x_m);
+    plan.sensor_y_m.push_back(s.y_m);
+    plan.sensor_mounting_rad.push_back(s.mounting_rad);
+    plan.sensor_fov_rad.push_back(s.fov_rad);
+    plan.sensor_cos_mounting.push_back(std::cos(s.mounting_rad));
+    plan.sensor_sin_mounting.push_back(std::sin(s.mounting_rad));
+}
+
+void compile_contour(GeometryPlan& plan, const std::vector<std::array<double, 2U>>& contour) {
+    const std::size_t n = contour.size();
+    plan.edge_x0.reserve(n);
+    plan.edge_y0.reserve(n);
+    plan.edge_y1.reserve(n);
+    plan.edge_dx_dy.reserve(n);
+    if (n == 0U) {
+        return;
+    }
+
+    plan.contour_min_x_m = std::numeric_limits<double>::max();
+    plan.contour_max_x_m = std::numeric_limits<double>::lowest();
+    plan.contour_min_y_m = std::numeric_limits<double>::max();
+    plan.contour_max_y_m = std::numeric_limits<double>::lowest();
+    for (std::size_t i = 0, j = n - 1U; i < n; j = i++) {
+        const double xi = contour[i][0];
+        const double yi = contour[i][1];
+        const double xj = contour[j][0];
+        const double yj = contour[j][1];
+        plan.edge_x0.push_back(xi);
+        plan.edge_y0.push_back(yi);
+        plan.edge_y1.push_back(yj);
+        plan.edge_dx_dy.push_back((xj - xi) / ((yj - yi) + std::numeric_limits<double>::epsilon()));
+
+        plan.contour_min_x_m = std::min(plan.contour_min_x_m, xi);
+        plan.contour_max_x_m = std::max(plan.contour_max_x_m, xi);
+        plan.contour_min_y_m = std::min(plan.contour_min_y_m, yi);
+        plan.contour_max_y_m = std::max(plan.contour_max_y_m, yi);
+    }
+}
+
+// Liang-Barsky clip of segment (x0, y0)-(x1, y1) against the rectangle [rx0, rx1] x [ry0, ry1].
+bool segment_touches_rect(double x0, double y0, double x1, double y1, double rx0, double ry0, double rx1, double ry1) {
+    const double dx = x1 - x0;
+    const double dy = y1 - y0;
+    double t0 = 0.0;
+    double t1 = 1.0;
+    const std::array<double, 4U> p{-dx, dx, -dy, dy};
+    const std::array<double, 4U> q{x0 - rx0, rx1 - x0, y0 - ry0, ry1 - y0};
+    for (std::size_t k = 0; k < 4U; ++k) {
+        if (p[k] == 0.0) {
+            if (q[k] < 0.0) {
+                return false;
+            }
+            continue;
+        }
+        const double t = q[k] / p[k];
+        if (p[k] < 0.0) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        if (t0 > t1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void compile_contour_raster(GeometryPlan& plan, const std::vector<std::array<double, 2U>>& contour) {
+    constexpr double kCellsAlongLongSide = 64.0;
+    // Cells within this distance of an edge are Boundary, which absorbs rounding in the cell lookup.
+    constexpr double kEdgeMarginM = 1.0e-6;
+
+    const double width = plan.contour_max_x_m - plan.contour_min_x_m;
+    const double height = plan.contour_max_y_m - plan.contour_min_y_m;
+    if (contour.size() < 3U || !(width > 0.0) || !(height > 0.0)) {
+        return;
+    }
+    const double cell = std::max(width, height) / kCellsAlongLongSide;
+    plan.contour_cells_x = static_cast<std::size_t>(std::max(1.0, std::ceil(width / cell)));
+    plan.contour_cells_y = static_cast<std::size_t>(std::max(1.0, std::ceil(height / cell)));
+    const double cell_w = width / static_cast<double>(plan.contour_cells_x);
+    const double cell_h = height / static_cast<double>(plan.contour_cells_y);
+    plan.contour_inv_cell_w = static_cast<double>(plan.contour_cells_x) / width;
+    plan.contour_inv_cell_h = static_cast<double>(plan.contour_cells_y) / height;
+    plan.contour_cells.assign(plan.contour_cells_x * plan.contour_cells_y, GeometryPlan::ContourCell::Outside);
+
+    const std::size_t n = contour.size();
+    for (std::size_t iy = 0; iy < plan.contour_cells_y; ++iy) {
+        for (std::size_t ix = 0; ix < plan.contour_cells_x; ++ix) {
+            const double x0 = plan.contour_min_x_m + static_cast<double>(ix) * cell_w;
+            const double y0 = plan.contour_min_y_m + static_cast<double>(iy) * cell_h;
+            bool near_edge = false;
+            for (std::size_t i = 0, j = n - 1U; i < n && !near_edge; j = i++) {
+                near_edge = segment_touches_rect(contour[j][0], contour[j][1], contour[i][0], contour[i][1],
+                                                 x0 - kEdgeMarginM, y0 - kEdgeMarginM, x0 + cell_w + kEdgeMarginM,
+                                                 y0 + cell_h + kEdgeMarginM);
+            }
+            auto& c = plan.contour_cells[iy * plan.contour_cells_x + ix];
+            if (near_edge) {
+                c = GeometryPlan::ContourCell::Boundary;
+            } else if (is_inside_vehicle_contour_exact(plan, x0 + 0.5 * cell_w, y0 + 0.5 * cell_h)) {
+                c = GeometryPlan::ContourCell::Inside;
+            }
+        }
+    }
+}
+
+void compile_sensor_pairs(GeometryPlan& plan) {
+    const int sensor_count = static_cast<int>(plan.sensor_x_m.size());
+    for (std::size_t group = 0; group < kSignalWayGroups; ++group) {
+        for (std::size_t id = 0; id < kSignalWaysPerGroup; ++id) {
+            int tx = 0;
+            int rx = 0;
+            if (!map_signal_way_to_sensor_pair(
+                    static_cast<std::uint8_t>(group), static_cast<std::uint8_t>(id), tx, rx)) {
+                continue;
+            }
+            if (tx < 0 || rx < 0 || tx >= sensor_count || rx >= sensor_count) {
+                continue;
+            }
+
+            const auto t = static_cast<std::size_t>(tx);
+            const auto r = static_cast<std::size_t>(rx);
+            auto& e = plan.pairs.entries[group * kSignalWaysPerGroup + id];
+            e.valid = true;
+            e.monostatic = (tx == rx);
+            e.tx = static_cast<std::uint8_t>(tx);
+            e.rx = static_cast<std::uint8_t>(rx);
+            e.center_x_m = 0.5 * (plan.sensor_x_m[t] + plan.sensor_x_m[r]);
+            e.center_y_m = 0.5 * (plan.sensor_y_m[t] + plan.sensor_y_m[r]);
+
+            const double dx = plan.sensor_x_m[r] - plan.sensor_x_m[t];
+            const double dy = plan.sensor_y_m[r] - plan.sensor_y_m[t];
+            e.half_baseline_m = 0.5 * std::sqrt(dx * dx + dy * dy);
+            e.ellipse_theta_rad = std::atan2(dy, dx);
+            e.fov_theta_rad = e.monostatic ? plan.sensor_mounting_rad[t]
+                                           : 0.5 * (plan.sensor_mounting_rad[t] + plan.sensor_mounting_rad[r]);
+
+            const std::array<double, 2U> d0{plan.sensor_cos_mounting[t], plan.sensor_sin_mounting[t]};
+            const std::array<double, 2U> d1{plan.sensor_cos_mounting[r], plan.sensor_sin_mounting[r]};
+            e.tx_x_m = plan.sensor_x_m[t];
+            e.tx_y_m = plan.sensor_y_m[t];
+            e.tx_dir_x = d0[0];
+            e.tx_dir_y = d0[1];
+
+            e.trace_dir_x = d0[0] + d1[0];
+            e.trace_dir_y = d0[1] + d1[1];
+            const double norm = std::sqrt(sqr(e.trace_dir_x) + sqr(e.trace_dir_y));
+            if (norm > 1.0e-9) {
+                e.trace_dir_x /= norm;
+                e.trace_dir_y /= norm;
+            }
+
+            // Bistatic: both center rays are fixed, so only the range gate remains per signal way.
+            const std::array<double, 2U> p0{plan.sensor_x_m[t], plan.sensor_y_m[t]};
+            const std::array<double, 2U> p1{plan.sensor_x_m[r], plan.sensor_y_m[r]};
+            std::array<double, 2U> ray{};
+            if (!e.monostatic && ray_intersection(p0, d0, p1, d1, ray) && point_in_sensor_sector(plan, t, ray) &&
+                point_in_sensor_sector(plan, r, ray)) {
+                e.ray_in_sectors = true;
+                e.ray_x_m = ray[0];
+                e.ray_y_m = ray[1];
+                e.ray_min_range_m = std::max(sensor_distance(plan, t, ray), sensor_distance(plan, r, ray));
+            }
+        }
+    }
+}
+
+void compile_sensor_gaps(GeometryPlan& plan) {
+    const std::size_t n = plan.sensor_x_m.size();
+    plan.sensor_gaps.assign(n * n, GeometryPlan::kNoSensorPath);
+    if (n == 0U) {
+        return;
+    }
+    // Link i joins sensor i to sensor (i + 1) % n.
+    std::vector<double> spacing(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = (i + 1U) % n;
+        spacing[i] = std::hypot(plan.sensor_x_m[j] - plan.sensor_x_m[i], plan.sensor_y_m[j] - plan.sensor_y_m[i]);
+    }
+    std::vector<double> sorted = spacing;
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(n / 2U), sorted.end());
+    const double max_spacing = 2.0 * sorted[n / 2U];
+    std::vector<bool> linked(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        linked[i] = spacing[i] <= max_spacing;
+    }
+
+    // Steps from `from` to `to` in increasing id order, or kNoSensorPath when a link on the way is missing.
+    const auto forward_steps = [&](std::size_t from, std::size_t to) {
+        const std::size_t steps = (to + n - from) % n;
+        for (std::size_t k = 0; k < steps; ++k) {
+            if (!linked[(from + k) % n]) {
+                return static_cast<std::size_t>(GeometryPlan::kNoSensorPath);
+            }
+        }
+        return steps;
+    };
+    for (std::size_t a = 0; a < n; ++a) {
+        for (std::size_t b = 0; b < n; ++b) {
+            const std::size_t steps = std::min(forward_steps(a, b), forward_steps(b, a));
+            plan.sensor_gaps[a * n + b] =
+                static_cast<std::uint8_t>(std::min<std::size_t>(steps, GeometryPlan::kNoSensorPath));
+        }
+    }
+}
+
+std::shared_ptr<const GeometryPlan> compile_plan(const std::vector<SensorPose>& sensors,
+                                                 const std::vector<std::array<double, 2U>>& contour) {
+    auto plan = std::make_shared<GeometryPlan>();
+    for (const auto& s : sensors) {
+        add_sensor(*plan, s);
+    }
+    compile_contour(*plan, contour);
+    compile_contour_raster(*plan, contour);
+    compile_sensor_pairs(*plan);
+    compile_sensor_gaps(*plan);
+    return plan;
+}
+
+}  // namespace
+
+std::shared_ptr<const GeometryPlan> compile_geometry_plan(const VehicleGeometry& geometry) {
+    std::vector<SensorPose> sensors;
+    sensors.reserve(geometry.sensors.size());
+    for (const auto& s : geometry.sensors) {
+        sensors.push_back(SensorPose{static_cast<double>(s.x_m),
+                                     static_cast<double>(s.y_m),
+                                     static_cast<double>(s.mounting_deg) * kDegToRad,
+                                     static_cast<double>(s.fov_deg) * kDegToRad});
+    }
+
+    std::vector<std::array<double, 2U>> contour;
+    contour.reserve(geometry.contour.size());
+    for (const auto& p : geometry.contour) {
+        contour.push_back({static_cast<double>(p.x_m), static_cast<double>(p.y_m)});
+    }
+    return compile_plan(sensors, contour);
+}
+
+std::shared_ptr<const GeometryPlan> default_geometry_plan() {
+    static const std::shared_ptr<const GeometryPlan> plan =
+        compile_plan(std::vector<SensorPose>(kDefaultSensors.begin(), kDefaultSensors.end()),
+                     std::vector<std::array<double, 2U>>(kDefaultContour.begin(), kDefaultContour.end()));
+    return plan;
+}
+
+bool is_inside_vehicle_contour(const GeometryPlan& plan, double x_m, double y_m) {
+    if (x_m < plan.contour_min_x_m || x_m > plan.contour_max_x_m || y_m < plan.contour_min_y_m ||
+        y_m > plan.contour_max_y_m) {
+        return false;
+    }
+    if (plan.contour_cells.empty()) {
+        return is_inside_vehicle_contour_exact(plan, x_m, y_m);
+    }
+    const std::size_t ix = std::min(static_cast<std::size_t>((x_m - plan.contour_min_x_m) * plan.contour_inv_cell_w),
+                                    plan.contour_cells_x - 1U);
+    const std::size_t iy = std::min(static_cast<std::size_t>((y_m - plan.contour_min_y_m) * plan.contour_inv_cell_h),
+                                    plan.contour_cells_y - 1U);
+    switch (plan.contour_cells[iy * plan.contour_cells_x + ix]) {
+        case GeometryPlan::ContourCell::Outside:
+            return false;
+        case GeometryPlan::ContourCell::Inside:
+            return true;
+        case GeometryPlan::ContourCell::Boundary:
+            break;
+    }
+    return is_inside_vehicle_contour_exact(plan, x_m, y_m);
+}
+
+bool is_inside_vehicle_contour_exact(const GeometryPlan& plan, double x_m, double y_m) {
+    if (x_m < plan.contour_min_x_m || x_m > plan.contour_max_x_m || y_m < plan.contour_min_y_m ||
+        y_m > plan.contour_max_y_m) {
+        return false;
+    }
+
+    bool inside = false;
+    const std::size_t n = plan.edge_x0.size();
+    for (std::size_t k = 0; k < n; ++k) {
+        const bool intersect = ((plan.edge_y0[k] > y_m) != (plan.edge_y1[k] > y_m)) &&
+                               (x_m < plan.edge_dx_dy[k] * (y_m - plan.edge_y0[k]) + plan.edge_x0[k]);
+        if (intersect) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,289 @@
+#include "ultrasound/intersection_lut.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ultrasound {
+namespace {
+
+constexpr std::uint64_t kFnvOffset = 0xCBF29CE484222325ULL;
+constexpr std::uint64_t kFnvPrime = 0x100000001B3ULL;
+
+void hash_bytes(std::uint64_t& h, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        h = (h ^ bytes[i]) * kFnvPrime;
+    }
+}
+
+void hash_double(std::uint64_t& h, double v) {
+    hash_bytes(h, &v, sizeof(v));
+}
+
+bool boxes_overlap(const PreparedEllipse& a, const PreparedEllipse& b) {
+    return a.max_x_m >= b.min_x_m && b.max_x_m >= a.min_x_m && a.max_y_m >= b.min_y_m && b.max_y_m >= a.min_y_m;
+}
+
+}  // namespace
+
+std::optional<EllipseModel> signal_way_ellipse(const SensorPairGeometry& pair, double range_m) {
+    if (range_m <= 0.0 || range_m <= pair.half_baseline_m) {
+        return std::nullopt;
+    }
+
+    EllipseModel model;
+    model.cx = pair.center_x_m;
+    model.cy = pair.center_y_m;
+    model.axis_a = range_m;
+    model.axis_b = std::sqrt(std::max(0.0, range_m * range_m - pair.half_baseline_m * pair.half_baseline_m));
+    model.theta = pair.ellipse_theta_rad;
+    return model;
+}
+
+std::uint64_t intersection_lut_fingerprint(const GeometryPlan& plan) {
+    std::uint64_t h = kFnvOffset;
+    const std::uint64_t sensors = plan.sensor_x_m.size();
+    hash_bytes(h, &sensors, sizeof(sensors));
+    for (std::size_t i = 0; i < plan.sensor_x_m.size(); ++i) {
+        hash_double(h, plan.sensor_x_m[i]);
+        hash_double(h, plan.sensor_y_m[i]);
+    }
+    for (const auto& entry : plan.pairs.entries) {
+        const std::uint8_t tag[3] = {static_cast<std::uint8_t>(entry.valid ? 1U : 0U), entry.tx, entry.rx};
+        hash_bytes(h, tag, sizeof(tag));
+        hash_double(h, entry.center_x_m);
+        hash_double(h, entry.center_y_m);
+        hash_double(h, entry.half_baseline_m);
+        hash_double(h, entry.ellipse_theta_rad);
+    }
+    return h;
+}
+
+std::shared_ptr<const IntersectionLut> build_intersection_lut(const GeometryPlan& plan,
+                                                              double min_range_m,
+                                                              double max_range_m,
+                                                              std::size_t resolution) {
+    auto lut = std::make_shared<IntersectionLut>();
+    lut->geometry_fingerprint = intersection_lut_fingerprint(plan);
+    lut->resolution = std::max<std::size_t>(resolution, 2U);
+    lut->min_range_m = min_range_m;
+    lut->max_range_m = std::max(max_range_m, min_range_m);
+    lut->step_m = (lut->max_range_m - lut->min_range_m) / static_cast<double>(lut->resolution - 1U);
+    if (!(lut->step_m > 0.0)) {
+        return lut;
+    }
+
+    const std::size_t n = plan.sensor_x_m.size();
+    lut->sensor_count = n;
+    lut->foci_index.assign(n * n, -1);
+    std::vector<const SensorPairGeometry*> representatives;
+    for (const auto& entry : plan.pairs.entries) {
+        const auto lo = static_cast<std::size_t>(std::min(entry.tx, entry.rx));
+        const auto hi = static_cast<std::size_t>(std::max(entry.tx, entry.rx));
+        if (!entry.valid || hi >= n) {
+            continue;
+        }
+        auto& index = lut->foci_index[lo * n + hi];
+        if (index < 0) {
+            index = static_cast<std::int32_t>(representatives.size());
+            representatives.push_back(&entry);
+        }
+    }
+    const std::size_t foci = representatives.size();
+    lut->foci_count = foci;
+    lut->table_index.assign(foci * foci, -1);
+
+    const std::size_t res = lut->resolution;
+    std::vector<std::vector<std::optional<EllipseModel>>> models(foci, std::vector<std::optional<EllipseModel>>(res));
+    for (std::size_t f = 0; f < foci; ++f) {
+        for (std::size_t k = 0; k < res; ++k) {
+            const double range = (k + 1U == res) ? lut->max_range_m : lut->min_range_m + static_cast<double>(k) * lut->step_m;
+            models[f][k] = signal_way_ellipse(*representatives[f], range);
+        }
+    }
+
+    EllipsePairSolution solution;
+    std::int32_t tables = 0;
+    for (std::size_t fa = 0; fa < foci; ++fa) {
+        for (std::size_t fb = fa + 1U; fb < foci; ++fb) {
+            // Ellipses of one sensor pair are nested and grow with range, so disjoint boxes at the largest
+            // range rule out any intersection.
+            const auto& far_a = models[fa][res - 1U];
+            const auto& far_b = models[fb][res - 1U];
+            if (!far_a.has_value() || !far_b.has_value() ||
+                !boxes_overlap(prepare_ellipse(*far_a), prepare_ellipse(*far_b))) {
+                continue;
+            }
+            lut->table_index[fa * foci + fb] = tables++;
+            const std::size_t base = lut->counts.size();
+            lut->counts.resize(base + res * res, IntersectionLut::kUndefined);
+            lut->points.resize((base + res * res) * IntersectionLut::kMaxPoints);
+            for (std::size_t ia = 0; ia < res; ++ia) {
+                for (std::size_t ib = 0; ib < res; ++ib) {
+                    const std::size_t node = base + ia * res + ib;
+                    const auto& a = models[fa][ia];
+                    const auto& b = models[fb][ib];
+                    if (!a.has_value() || !b.has_value() || !solve_ellipse_intersections(*a, *b, solution)) {
+                        continue;
+                    }
+                    lut->counts[node] = static_cast<std::uint8_t>(solution.point_count);
+                    for (std::size_t k = 0; k < solution.point_count; ++k) {
+                        lut->points[node * IntersectionLut::kMaxPoints + k] = {static_cast<float>(solution.points[k][0]),
+                                                                               static_cast<float>(solution.points[k][1])};
+                    }
+                }
+            }
+        }
+    }
+    return lut;
+}
+
+bool intersection_lut_matches(const IntersectionLut& lut,
+                              const GeometryPlan& plan,
+                              double min_range_m,
+                              double max_range_m,
+                              std::size_t resolution) {
+    return lut.geometry_fingerprint == intersection_lut_fingerprint(plan) &&
+           lut.resolution == std::max<std::size_t>(resolution, 2U) && lut.min_range_m == min_range_m &&
+           lut.max_range_m == std::max(max_range_m, min_range_m);
+}
+
+bool lookup_intersections(const IntersectionLut& lut,
+                          const ModelOrigin& a,
+                          double range_a_m,
+                          const ModelOrigin& b,
+                          double range_b_m,
+                          EllipsePairSolution& solution) {
+    solution = EllipsePairSolution{};
+    const std::size_t n = lut.sensor_count;
+    if (a.sensor_hi >= n || b.sensor_hi >= n) {
+        return false;
+    }
+    std::int32_t fa = lut.foci_index[a.sensor_lo * n + a.sensor_hi];
+    std::int32_t fb = lut.foci_index[b.sensor_lo * n + b.sensor_hi];
+    if (fa < 0 || fb < 0 || fa == fb) {
+        return false;
+    }
+    if (fa > fb) {
+        std::swap(fa, fb);
+        std::swap(range_a_m, range_b_m);
+    }
+    const std::int32_t table = lut.table_index[static_cast<std::size_t>(fa) * lut.foci_count + static_cast<std::size_t>(fb)];
+    if (table < 0) {
+        return false;
+    }
+
+    const double last = static_cast<double>(lut.resolution - 1U);
+    const double ua = (range_a_m - lut.min_range_m) / lut.step_m;
+    const double ub = (range_b_m - lut.min_range_m) / lut.step_m;
+    if (!(ua >= 0.0 && ua <= last && ub >= 0.0 && ub <= last)) {
+        return false;
+    }
+    const std::size_t ia = std::min(static_cast<std::size_t>(ua), lut.resolution - 2U);
+    const std::size_t ib = std::min(static_cast<std::size_t>(ub), lut.resolution - 2U);
+    const double wa = ua - static_cast<double>(ia);
+    const double wb = ub - static_cast<double>(ib);
+
+    const std::size_t n00 = (static_cast<std::size_t>(table) * lut.resolution + ia) * lut.resolution + ib;
+    const std::array<std::size_t, 4U> nodes{n00, n00 + lut.resolution, n00 + 1U, n00 + lut.resolution + 1U};
+    const std::array<double, 4U> weights{(1.0 - wa) * (1.0 - wb), wa * (1.0 - wb), (1.0 - wa) * wb, wa * wb};
+    const std::uint8_t count = lut.counts[n00];
+    if (count == 0U || count == IntersectionLut::kUndefined) {
+        return false;
+    }
+    for (const std::size_t node : nodes) {
+        if (lut.counts[node] != count) {
+            return false;
+        }
+    }
+
+    // Node roots are unordered: pair each root of the first node with the nearest unused root of the others.
+    // The match must be closer than half the gap to the first node's other roots, otherwise the roots swap
+    // places within the cell (near tangency) and the pair is left to the solver.
+    std::array<std::uint8_t, 4U> used{};
+    for (std::size_t k = 0; k < count; ++k) {
+        const auto& p0 = lut.points[n00 * IntersectionLut::kMaxPoints + k];
+        double max_travel_sq = std::numeric_limits<double>::infinity();
+        for (std::size_t m = 0; m < count; ++m) {
+            const auto& q = lut.points[n00 * IntersectionLut::kMaxPoints + m];
+            const double dx = static_cast<double>(q[0]) - static_cast<double>(p0[0]);
+            const double dy = static_cast<double>(q[1]) - static_cast<double>(p0[1]);
+            if (m != k) {
+                max_travel_sq = std::min(max_travel_sq, 0.25 * (dx * dx + dy * dy));
+            }
+        }
+        double x = weights[0] * static_cast<double>(p0[0]);
+        double y = weights[0] * static_cast<double>(p0[1]);
+        for (std::size_t c = 1; c < nodes.size(); ++c) {
+            std::size_t best = count;
+            double best_d = max_travel_sq;
+            for (std::size_t m = 0; m < count; ++m) {
+                const auto& q = lut.points[nodes[c] * IntersectionLut::kMaxPoints + m];
+                const double dx = static_cast<double>(q[0]) - static_cast<double>(p0[0]);
+                const double dy = static_cast<double>(q[1]) - static_cast<double>(p0[1]);
+                const double d = dx * dx + dy * dy;
+                if ((used[c] & (1U << m)) == 0U && d < best_d) {
+                    best = m;
+                    best_d = d;
+                }
+            }
+            if (best == count) {
+                return false;
+            }
+            used[c] = static_cast<std::uint8_t>(used[c] | (1U << best));
+            const auto& q = lut.points[nodes[c] * IntersectionLut::kMaxPoints + best];
+            x += weights[c] * static_cast<double>(q[0]);
+            y += weights[c] * static_cast<double>(q[1]);
+        }
+        solution.points[k] = {x, y};
+    }
+    solution.point_count = count;
+    solution.closest_point = solution.points[0];
+    solution.closest_error = 0.0;
+    return true;
+}
+
+bool polish_intersection(const PreparedEllipse& a, const PreparedEllipse& b, std::array<double, 2U>& p) {
+    // f = xr^2 / A^2 + yr^2 / B^2 - 1 in each ellipse's frame; its gradient rotated back to world axes.
+    const auto residual = [&p](const PreparedEllipse& e, double& f, double& gx, double& gy) {
+        const double dx = p[0] - e.model.cx;
+        const double dy = p[1] - e.model.cy;
+        const double xr = dx * e.cos_theta + dy * e.sin_theta;
+        const double yr = dy * e.cos_theta - dx * e.sin_theta;
+        const double u = 2.0 * xr / e.axis_a_sq;
+        const double v = 2.0 * yr / e.axis_b_sq;
+        f = (xr * xr / e.axis_a_sq + yr * yr / e.axis_b_sq) - 1.0;
+        gx = u * e.cos_theta - v * e.sin_theta;
+        gy = u * e.sin_theta + v * e.cos_theta;
+    };
+    constexpr int kSteps = 2;
+    constexpr double kResidualLimit = 1.0e-6;
+    double fa = 0.0;
+    double ax = 0.0;
+    double ay = 0.0;
+    double fb = 0.0;
+    double bx = 0.0;
+    double by = 0.0;
+    for (int step = 0; step < kSteps; ++step) {
+        residual(a, fa, ax, ay);
+        residual(b, fb, bx, by);
+        const double det = ax * by - ay * bx;
+        if (std::fabs(det) <= 1.0e-12 * (ax * ax + ay * ay + bx * bx + by * by)) {
+            return false;
+        }
+        p[0] -= (fa * by - fb * ay) / det;
+        p[1] -= (ax * fb - bx * fa) / det;
+    }
+    residual(a, fa, ax, ay);
+    residual(b, fb, bx, by);
+    return std::fabs(fa) <= kResidualLimit && std::fabs(fb) <= kResidualLimit;
+}
+
+}  // namespace ultrasound
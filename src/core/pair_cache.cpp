@@ -0,0 +1,156 @@
+#include "ultrasound/pair_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ultrasound {
+namespace {
+
+std::uint64_t mix(std::uint64_t h) {
+    h = (h ^ (h >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27U)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31U);
+}
+
+}  // namespace
+
+std::uint64_t pair_cache_model_key(std::uint8_t group_id,
+                                   std::uint8_t signal_way_id,
+                                   float distance_m,
+                                   float quantization_m) {
+    std::uint32_t range_bits = 0U;
+    if (quantization_m > 0.0F) {
+        range_bits = static_cast<std::uint32_t>(std::llround(static_cast<double>(distance_m) / quantization_m));
+    } else {
+        std::memcpy(&range_bits, &distance_m, sizeof(range_bits));
+    }
+    return (static_cast<std::uint64_t>(group_id) << 40U) | (static_cast<std::uint64_t>(signal_way_id) << 32U) |
+           range_bits;
+}
+
+double pair_cache_range(float distance_m, float quantization_m) {
+    if (quantization_m > 0.0F) {
+        const double step = static_cast<double>(quantization_m);
+        return static_cast<double>(std::llround(static_cast<double>(distance_m) / step)) * step;
+    }
+    return static_cast<double>(distance_m);
+}
+
+PairIntersectionCache::PairIntersectionCache(std::size_t capacity) : entries_(capacity) {
+    std::size_t slots = 1U;
+    while (slots < 2U * capacity) {
+        slots *= 2U;
+    }
+    slots_.assign(capacity > 0U ? slots : 0U, kNone);
+}
+
+void PairIntersectionCache::clear() {
+    std::fill(slots_.begin(), slots_.end(), kNone);
+    size_ = 0U;
+    head_ = kNone;
+    tail_ = kNone;
+}
+
+std::size_t PairIntersectionCache::home_slot(const PairCacheKey& key) const {
+    return static_cast<std::size_t>(mix(key.a ^ mix(key.b))) & (slots_.size() - 1U);
+}
+
+std::size_t PairIntersectionCache::find_slot(const PairCacheKey& key) const {
+    const std::size_t mask = slots_.size() - 1U;
+    std::size_t i = home_slot(key);
+    while (slots_[i] != kNone && !(entries_[slots_[i]].key == key)) {
+        i = (i + 1U) & mask;
+    }
+    return i;
+}
+
+// Backward-shift deletion keeps every probe chain gap-free without tombstones.
+void PairIntersectionCache::erase_slot(std::size_t slot) {
+    const std::size_t mask = slots_.size() - 1U;
+    std::size_t hole = slot;
+    std::size_t i = (slot + 1U) & mask;
+    while (slots_[i] != kNone) {
+        const std::size_t home = home_slot(entries_[slots_[i]].key);
+        // Move the entry back when the hole lies on its probe path (cyclically between home and i).
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            slots_[hole] = slots_[i];
+            hole = i;
+        }
+        i = (i + 1U) & mask;
+    }
+    slots_[hole] = kNone;
+}
+
+void PairIntersectionCache::unlink(std::uint32_t entry) {
+    auto& e = entries_[entry];
+    if (e.prev != kNone) {
+        entries_[e.prev].next = e.next;
+    } else {
+        head_ = e.next;
+    }
+    if (e.next != kNone) {
+        entries_[e.next].prev = e.prev;
+    } else {
+        tail_ = e.prev;
+    }
+    e.prev = kNone;
+    e.next = kNone;
+}
+
+void PairIntersectionCache::push_front(std::uint32_t entry) {
+    auto& e = entries_[entry];
+    e.prev = kNone;
+    e.next = head_;
+    if (head_ != kNone) {
+        entries_[head_].prev = entry;
+    }
+    head_ = entry;
+    if (tail_ == kNone) {
+        tail_ = entry;
+    }
+}
+
+const PairIntersections* PairIntersectionCache::find(const PairCacheKey& key) {
+    if (size_ == 0U) {
+        return nullptr;
+    }
+    const std::uint32_t entry = slots_[find_slot(key)];
+    if (entry == kNone) {
+        return nullptr;
+    }
+    if (entry != head_) {
+        unlink(entry);
+        push_front(entry);
+    }
+    return &entries_[entry].value;
+}
+
+void PairIntersectionCache::insert(const PairCacheKey& key, const PairIntersections& value) {
+    if (entries_.empty()) {
+        return;
+    }
+    std::size_t slot = find_slot(key);
+    std::uint32_t entry = slots_[slot];
+    if (entry != kNone) {
+        unlink(entry);
+    } else if (size_ < entries_.size()) {
+        entry = static_cast<std::uint32_t>(size_++);
+        slots_[slot] = entry;
+    } else {
+        entry = tail_;
+        unlink(entry);
+        erase_slot(find_slot(entries_[entry].key));
+        slot = find_slot(key);
+        slots_[slot] = entry;
+    }
+    auto& e = entries_[entry];
+    e.key = key;
+    e.value.points.assign(value.points.begin(), value.points.end());
+    e.value.deferred_begin = value.deferred_begin;
+    push_front(entry);
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,94 @@
+#include "ultrasound/pair_candidates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ultrasound {
+namespace {
+
+constexpr double kRoundingMargin = 1.0e-9;
+
+// Sensors outside the table count as unconnected.
+std::size_t table_gap(std::uint8_t a, std::uint8_t b, const PairPruningRules& rules) {
+    if (a >= rules.sensor_count || b >= rules.sensor_count) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    return (*rules.sensor_gaps)[a * rules.sensor_count + b];
+}
+
+std::size_t sensor_gap(const ModelOrigin& a, const ModelOrigin& b, const PairPruningRules& rules) {
+    return std::min({table_gap(a.sensor_lo, b.sensor_lo, rules), table_gap(a.sensor_lo, b.sensor_hi, rules),
+                     table_gap(a.sensor_hi, b.sensor_lo, rules), table_gap(a.sensor_hi, b.sensor_hi, rules)});
+}
+
+bool pruned_by_rules(const ModelOrigin& a, const ModelOrigin& b, const PairPruningRules& rules) {
+    if (rules.skip_cross_group && a.group != b.group) {
+        return true;
+    }
+    return rules.max_sensor_gap > 0U && rules.sensor_gaps != nullptr && sensor_gap(a, b, rules) > rules.max_sensor_gap;
+}
+
+// Points of `a` where b's implicit value is at most `limit` lie inside b scaled by sqrt(1 + limit), using the
+// clamped axes b's implicit equation divides by.
+bool out_of_reach(const PreparedEllipse& a, const PreparedEllipse& b, double limit) {
+    const double scale = std::sqrt(1.0 + limit) * (1.0 + kRoundingMargin);
+    const double b_axis_a = std::sqrt(b.axis_a_sq) * scale + kRoundingMargin;
+    const double b_axis_b = std::sqrt(b.axis_b_sq) * scale + kRoundingMargin;
+
+    const double dx = a.model.cx - b.model.cx;
+    const double dy = a.model.cy - b.model.cy;
+    const double reach = std::max(std::fabs(a.model.axis_a), std::fabs(a.model.axis_b)) + std::max(b_axis_a, b_axis_b);
+    if (dx * dx + dy * dy > reach * reach) {
+        return true;
+    }
+
+    const double half_w = std::hypot(b_axis_a * b.cos_theta, b_axis_b * b.sin_theta);
+    const double half_h = std::hypot(b_axis_a * b.sin_theta, b_axis_b * b.cos_theta);
+    if (a.max_x_m < b.model.cx - half_w || a.min_x_m > b.model.cx + half_w || a.max_y_m < b.model.cy - half_h ||
+        a.min_y_m > b.model.cy + half_h) {
+        return true;
+    }
+
+    double lo = 0.0;
+    double hi = 0.0;
+    return circle_implicit_range(a, b, lo, hi) && (lo > limit || hi < -limit);
+}
+
+}  // namespace
+
+ModelOrigin make_model_origin(std::uint8_t group, std::uint8_t tx, std::uint8_t rx) {
+    return {group, std::min(tx, rx), std::max(tx, rx)};
+}
+
+bool same_sensor_pair(const ModelOrigin& a, const ModelOrigin& b) {
+    return a.sensor_lo == b.sensor_lo && a.sensor_hi == b.sensor_hi;
+}
+
+void generate_candidate_pairs(const std::vector<PreparedEllipse>& models,
+                              const std::vector<ModelOrigin>& origins,
+                              const PairPruningRules& rules,
+                              double implicit_limit,
+                              std::vector<ModelPair>& out,
+                              PairGenerationStats& stats) {
+    out.clear();
+    for (std::size_t i = 0; i + 1U < models.size(); ++i) {
+        for (std::size_t j = i + 1U; j < models.size(); ++j) {
+            if (rules.skip_same_sensor_pair && same_sensor_pair(origins[i], origins[j])) {
+                ++stats.same_sensor_pair;
+                continue;
+            }
+            if (pruned_by_rules(origins[i], origins[j], rules) || out_of_reach(models[i], models[j], implicit_limit)) {
+                ++stats.pruned;
+                continue;
+            }
+            out.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j)});
+            ++stats.emitted;
+        }
+    }
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,78 @@
+#include "ultrasound/pair_sweep.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace ultrasound {
+namespace {
+
+// Tolerance sweep over b's implicit values at a's samples: every sample within `tolerance`, then the best
+// sample if within `best_limit`, each handed to `sink` unless it lies inside the vehicle contour.
+template <typename Sink>
+void scan_tolerance_hits(const GeometryPlan& plan,
+                         const EllipseSampleBlock& a_samples,
+                         const std::array<double, kEllipseSamples + 1U>& values,
+                         double tolerance,
+                         double best_limit,
+                         Sink&& sink) {
+    double best_err = std::numeric_limits<double>::max();
+    std::array<double, 2U> best_pt{};
+    for (std::size_t s = 0; s < kEllipseSamples; ++s) {
+        const std::array<double, 2U> p{a_samples.x[s], a_samples.y[s]};
+        const double err = std::fabs(values[s]);
+        if (err < best_err) {
+            best_err = err;
+            best_pt = p;
+        }
+        if (err <= tolerance && !is_inside_vehicle_contour(plan, p[0], p[1])) {
+            sink(p);
+        }
+    }
+    if (best_err <= best_limit && !is_inside_vehicle_contour(plan, best_pt[0], best_pt[1])) {
+        sink(best_pt);
+    }
+}
+
+}  // namespace
+
+void collect_pair_fused(const GeometryPlan& plan,
+                        const PreparedEllipse& a,
+                        const EllipseSampleBlock& a_samples,
+                        const PreparedEllipse& b,
+                        PairScratch& scratch,
+                        double tolerance,
+                        double best_limit,
+                        PairIntersections& result) {
+    auto& values = scratch.implicit_values;
+    ellipse_implicit_values(b, a_samples.x.data(), a_samples.y.data(), values.data(), values.size());
+    auto& roots = scratch.roots;
+    roots.clear();
+    sample_ellipse_intersections(a, values, b, roots);
+    for (const auto& root_p : roots) {
+        if (!is_inside_vehicle_contour(plan, root_p[0], root_p[1])) {
+            result.points.push_back(root_p);
+        }
+    }
+    result.deferred_begin = result.points.size();
+    scan_tolerance_hits(plan, a_samples, values, tolerance, best_limit, [&](const std::array<double, 2U>& p) {
+        result.points.push_back(p);
+    });
+}
+
+void collect_pair_tolerance_hits(const GeometryPlan& plan,
+                                 const EllipseSampleBlock& a_samples,
+                                 const PreparedEllipse& b,
+                                 PairScratch& scratch,
+                                 double tolerance,
+                                 double best_limit,
+                                 PairIntersections& result) {
+    auto& values = scratch.implicit_values;
+    ellipse_implicit_values(b, a_samples.x.data(), a_samples.y.data(), values.data(), kEllipseSamples);
+    scan_tolerance_hits(plan, a_samples, values, tolerance, best_limit, [&](const std::array<double, 2U>& p) {
+        result.points.push_back(p);
+    });
+}
+
+}  // namespace ultrasound
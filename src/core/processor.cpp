@@ -2,56 +2,33 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <numbers>
 #include <optional>
-#include <unordered_map>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "ultrasound/clustering.hpp"
+#include "ultrasound/ellipse_intersection.hpp"
+#include "ultrasound/ellipse_kernel.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/intersection_lut.hpp"
+#include "ultrasound/pair_cache.hpp"
+#include "ultrasound/pair_candidates.hpp"
+#include "ultrasound/pair_sweep.hpp"
+#include "ultrasound/spatial_index.hpp"
+#include "ultrasound/thread_pool.hpp"
+
 namespace ultrasound {
 namespace {
 
-struct SensorPose {
-    double x_m{0.0};
-    double y_m{0.0};
-    double mounting_rad{0.0};
-    double fov_rad{100.0 * (std::numbers::pi_v<double> / 180.0)};
-};
-
-struct EllipseModel {
-    double cx{0.0};
-    double cy{0.0};
-    double axis_a{1.0};
-    double axis_b{1.0};
-    double theta{0.0};
-};
-
-constexpr std::array<SensorPose, 12U> kDefaultSensors{
-    SensorPose{3.238, 0.913, 87.0 * (std::numbers::pi_v<double> / 180.0), 60.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{3.6, 0.715, 38.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{3.804, 0.276, 7.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{3.804, -0.276, -4.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{3.6, -0.715, -28.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{3.238, -0.913, -87.0 * (std::numbers::pi_v<double> / 180.0), 45.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{-0.775, -0.822, -100.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{-0.956, -0.71, -165.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{-1.09, -0.25, -175.0 * (std::numbers::pi_v<double> / 180.0), 75.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{-1.09, 0.25, 173.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{-0.956, 0.71, 151.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
-    SensorPose{-0.775, 0.822, 99.0 * (std::numbers::pi_v<double> / 180.0), 100.0 * (std::numbers::pi_v<double> / 180.0)},
-};
-
-constexpr std::array<std::array<double, 2U>, 12U> kDefaultContour{
-    std::array<double, 2U>{-0.775, 0.822}, std::array<double, 2U>{-0.956, 0.71}, std::array<double, 2U>{-1.09, 0.25},
-    std::array<double, 2U>{-1.09, -0.25}, std::array<double, 2U>{-0.956, -0.71}, std::array<double, 2U>{-0.775, -0.822},
-    std::array<double, 2U>{3.238, -0.913}, std::array<double, 2U>{3.6, -0.715}, std::array<double, 2U>{3.804, -0.276},
-    std::array<double, 2U>{3.804, 0.276}, std::array<double, 2U>{3.6, 0.715}, std::array<double, 2U>{3.238, 0.913},
-};
-
 bool group_matches(GroupFilter filter, std::uint8_t group_id) {
     if (group_id > 1U) {
         return false;
@@ -67,469 +44,451 @@ bool group_matches(GroupFilter filter, std::uint8_t group_id) {
     return true;
 }
 
-double sqr(double value) {
-    return value * value;
+// The pair cache keys quantized ranges, so with a quantization step the models are built at the quantized range.
+std::optional<EllipseModel> build_ellipse_from_signal_way(const SensorPairGeometry& pair,
+                                                          const SignalWay& sw,
+                                                          float quantization_m) {
+    return signal_way_ellipse(pair, pair_cache_range(sw.distance_m, quantization_m));
 }
 
-bool map_signal_way_to_sensor_pair(std::uint8_t group_id, std::uint8_t signal_way_id, int& tx, int& rx) {
-    const int base = (group_id == 1U) ? 6 : 0;
-    if (group_id > 1U || signal_way_id > 15U) {
-        return false;
+std::optional<EllipseModel> build_fov_model_from_signal_way(const SensorPairGeometry& pair,
+                                                            const SignalWay& sw,
+                                                            float quantization_m) {
+    const double distance = pair_cache_range(sw.distance_m, quantization_m);
+    if (distance <= 0.0) {
+        return std::nullopt;
     }
 
-    switch (signal_way_id) {
-        case 0:
-            tx = base + 0;
-            rx = base + 0;
-            return true;
-        case 1:
-            tx = base + 0;
-            rx = base + 1;
-            return true;
-        case 2:
-            tx = base + 1;
-            rx = base + 0;
-            return true;
-        case 3:
-            tx = base + 1;
-            rx = base + 1;
-            return true;
-        case 4:
-            tx = base + 1;
-            rx = base + 2;
-            return true;
-        case 5:
-            tx = base + 2;
-            rx = base + 1;
-            return true;
-        case 6:
-            tx = base + 2;
-            rx = base + 2;
-            return true;
-        case 7:
-            tx = base + 2;
-            rx = base + 3;
-            return true;
-        case 8:
-            tx = base + 3;
-            rx = base + 2;
-            return true;
-        case 9:
-            tx = base + 3;
-            rx = base + 3;
-            return true;
-        case 10:
-            tx = base + 3;
-            rx = base + 4;
-            return true;
-        case 11:
-            tx = base + 4;
-            rx = base + 3;
-            return true;
-        case 12:
-            tx = base + 4;
-            rx = base + 4;
-            return true;
-        case 13:
-            tx = base + 4;
-            rx = base + 5;
-            return true;
-        case 14:
-            tx = base + 5;
-            rx = base + 4;
-            return true;
-        case 15:
-            tx = base + 5;
-            rx = base + 5;
-            return true;
-        default:
-            return false;
-    }
+    EllipseModel model;
+    model.cx = pair.center_x_m;
+    model.cy = pair.center_y_m;
+    model.axis_a = distance;
+    model.axis_b = pair.monostatic ? distance : std::max(0.25 * distance, pair.half_baseline_m);
+    model.theta = pair.fov_theta_rad;
+    return model;
 }
 
-bool is_inside_vehicle_contour(double x_m, double y_m) {
-    bool inside = false;
-    for (std::size_t i = 0, j = kDefaultContour.size() - 1U; i < kDefaultContour.size(); j = i++) {
-        const double xi = kDefaultContour[i][0];
-        const double yi = kDefaultContour[i][1];
-        const double xj = kDefaultContour[j][0];
-        const double yj = kDefaultContour[j][1];
-
-        const bool intersect = ((yi > y_m) != (yj > y_m)) &&
-                               (x_m < (xj - xi) * (y_m - yi) / ((yj - yi) + std::numeric_limits<double>::epsilon()) + xi);
-        if (intersect) {
-            inside = !inside;
-        }
+std::array<double, 2U> tracing_detection_from_signal_way(const SensorPairGeometry* pair, const SignalWay& sw) {
+    const double distance = static_cast<double>(sw.distance_m);
+    if (pair == nullptr) {
+        return {distance, sw.group_id == 0U ? 1.0 : -1.0};
     }
-    return inside;
-}
-
-std::array<double, 2U> ellipse_point(const EllipseModel& e, double param_t) {
-    const double ct = std::cos(param_t);
-    const double st = std::sin(param_t);
-    const double cp = std::cos(e.theta);
-    const double sp = std::sin(e.theta);
-
-    const double x_local = e.axis_a * ct;
-    const double y_local = e.axis_b * st;
-    return {e.cx + x_local * cp - y_local * sp, e.cy + x_local * sp + y_local * cp};
+    return {pair->center_x_m + distance * pair->trace_dir_x, pair->center_y_m + distance * pair->trace_dir_y};
 }
 
-double ellipse_implicit_error(const EllipseModel& e, double x_m, double y_m) {
-    const double dx = x_m - e.cx;
-    const double dy = y_m - e.cy;
-    const double cp = std::cos(e.theta);
-    const double sp = std::sin(e.theta);
-    const double xr = dx * cp + dy * sp;
-    const double yr = -dx * sp + dy * cp;
-    const double v = sqr(xr) / std::max(sqr(e.axis_a), 1.0e-9) + sqr(yr) / std::max(sqr(e.axis_b), 1.0e-9);
-    return std::fabs(v - 1.0);
-}
-
-void push_unique_detection(std::vector<std::array<double, 2U>>& detections, const std::array<double, 2U>& candidate) {
-    constexpr double kMinSepSq = 0.08 * 0.08;
-    for (const auto& p : detections) {
-        const double dx = p[0] - candidate[0];
-        const double dy = p[1] - candidate[1];
-        if ((dx * dx + dy * dy) <= kMinSepSq) {
-            return;
-        }
-    }
-    detections.push_back(candidate);
+std::array<double, 2U> fov_detection_from_signal_way(const SensorPairGeometry& pair, const SignalWay& sw) {
+    const auto tracing = tracing_detection_from_signal_way(&pair, sw);
+    return {tracing[0] * 0.98, tracing[1] * 0.98};
 }
 
-std::optional<EllipseModel> build_ellipse_from_signal_way(const SignalWay& sw) {
-    int tx = 0;
-    int rx = 0;
-    if (!map_signal_way_to_sensor_pair(sw.group_id, sw.signal_way_id, tx, rx)) {
-        return std::nullopt;
-    }
-
-    if (tx < 0 || rx < 0 || tx >= static_cast<int>(kDefaultSensors.size()) || rx >= static_cast<int>(kDefaultSensors.size())) {
+std::optional<std::array<double, 2U>> fov_pie_detection(const SensorPairGeometry& pair, const SignalWay& sw) {
+    const double range_m = static_cast<double>(sw.distance_m);
+    if (range_m <= 0.0) {
         return std::nullopt;
     }
 
-    const auto& s0 = kDefaultSensors[tx];
-    const auto& s1 = kDefaultSensors[rx];
-    const double distance = static_cast<double>(sw.distance_m);
-    if (distance <= 0.0) {
-        return std::nullopt;
+    // Monostatic: detection at the middle of the sensor's FOV arc.
+    if (pair.monostatic) {
+        return std::array<double, 2U>{pair.tx_x_m + range_m * pair.tx_dir_x, pair.tx_y_m + range_m * pair.tx_dir_y};
     }
 
-    const double dx = s1.x_m - s0.x_m;
-    const double dy = s1.y_m - s0.y_m;
-    const double sensor_distance = std::sqrt(dx * dx + dy * dy);
-    const double half_sensor_distance = 0.5 * sensor_distance;
-
-    if (distance <= half_sensor_distance) {
-        return std::nullopt;
+    // Bistatic: source location approximated by intersection of both sensors center rays.
+    if (pair.ray_in_sectors && pair.ray_min_range_m <= range_m + 1.0e-6) {
+        return std::array<double, 2U>{pair.ray_x_m, pair.ray_y_m};
     }
 
-    EllipseModel model;
-    model.cx = 0.5 * (s0.x_m + s1.x_m);
-    model.cy = 0.5 * (s0.y_m + s1.y_m);
-    model.axis_a = distance;
-    model.axis_b = std::sqrt(std::max(0.0, distance * distance - half_sensor_distance * half_sensor_distance));
-    model.theta = std::atan2(dy, dx);
-    return model;
+    // Fallback when center rays don't intersect in valid sectors.
+    return fov_detection_from_signal_way(pair, sw);
 }
 
-std::optional<EllipseModel> build_fov_model_from_signal_way(const SignalWay& sw) {
-    int tx = 0;
-    int rx = 0;
-    if (!map_signal_way_to_sensor_pair(sw.group_id, sw.signal_way_id, tx, rx)) {
-        return std::nullopt;
-    }
-    if (tx < 0 || rx < 0 || tx >= static_cast<int>(kDefaultSensors.size()) || rx >= static_cast<int>(kDefaultSensors.size())) {
-        return std::nullopt;
-    }
-
-    const auto& s0 = kDefaultSensors[tx];
-    const auto& s1 = kDefaultSensors[rx];
-    const double distance = static_cast<double>(sw.distance_m);
-    if (distance <= 0.0) {
-        return std::nullopt;
+// Drops models identical to an earlier one (same foci and range, e.g. tx 0 -> rx 1 and tx 1 -> rx 0) and
+// returns how many pair evaluations that saves.
+std::uint64_t merge_duplicate_ellipses(std::vector<PreparedEllipse>& models,
+                                       std::vector<ModelOrigin>& origins,
+                                       std::vector<std::uint64_t>& keys) {
+    const std::size_t before = models.size();
+    std::size_t kept = 0U;
+    for (std::size_t i = 0; i < before; ++i) {
+        bool duplicate = false;
+        for (std::size_t k = 0; k < kept && !duplicate; ++k) {
+            duplicate = same_sensor_pair(origins[k], origins[i]) && models[k].model.axis_a == models[i].model.axis_a;
+        }
+        if (!duplicate) {
+            models[kept] = models[i];
+            origins[kept] = origins[i];
+            keys[kept] = keys[i];
+            ++kept;
+        }
     }
+    models.resize(kept);
+    origins.resize(kept);
+    keys.resize(kept);
+    return static_cast<std::uint64_t>(before) * (before - 1U) / 2U - static_cast<std::uint64_t>(kept) * (kept - 1U) / 2U;
+}
 
-    EllipseModel model;
-    model.cx = 0.5 * (s0.x_m + s1.x_m);
-    model.cy = 0.5 * (s0.y_m + s1.y_m);
-
-    if (tx == rx) {
-        model.axis_a = distance;
-        model.axis_b = distance;
-        model.theta = s0.mounting_rad;
-    } else {
-        const double baseline = std::sqrt(sqr(s1.x_m - s0.x_m) + sqr(s1.y_m - s0.y_m));
-        model.axis_a = distance;
-        model.axis_b = std::max(0.25 * distance, 0.5 * baseline);
-        model.theta = 0.5 * (s0.mounting_rad + s1.mounting_rad);
+// Samples `models[i]` into the scratch unless it already holds them.
+void sample_model(const std::vector<PreparedEllipse>& models, std::size_t i, PairScratch& scratch) {
+    if (scratch.sampled_model != i) {
+        sample_ellipse(models[i], scratch.samples);
+        scratch.sampled_model = i;
     }
-    return model;
 }
 
-std::array<double, 2U> tracing_detection_from_signal_way(const SignalWay& sw) {
-    int tx = 0;
-    int rx = 0;
-    if (!map_signal_way_to_sensor_pair(sw.group_id, sw.signal_way_id, tx, rx)) {
-        return {static_cast<double>(sw.distance_m), sw.group_id == 0U ? 1.0 : -1.0};
+// Solver roots outside the contour; a near miss contributes its closest approach within `best_limit`. Pairs the
+// solver rejects fall back to the sampled traverse + tolerance sweep for that pair only.
+template <typename Solver>
+void collect_pair_solved(const GeometryPlan& plan,
+                         const std::vector<PreparedEllipse>& models,
+                         const ModelPair& pair,
+                         PairScratch& scratch,
+                         Diagnostics& diagnostics,
+                         double tolerance,
+                         double best_limit,
+                         Solver&& solve,
+                         PairIntersections& result) {
+    EllipsePairSolution solution;
+    if (!solve(pair, diagnostics, solution)) {
+        sample_model(models, pair.i, scratch);
+        collect_pair_fused(plan, models[pair.i], scratch.samples, models[pair.j], scratch, tolerance, best_limit, result);
+        return;
     }
-    if (tx < 0 || rx < 0 || tx >= static_cast<int>(kDefaultSensors.size()) || rx >= static_cast<int>(kDefaultSensors.size())) {
-        return {static_cast<double>(sw.distance_m), sw.group_id == 0U ? 1.0 : -1.0};
+    for (std::size_t k = 0; k < solution.point_count; ++k) {
+        const auto& p = solution.points[k];
+        if (!is_inside_vehicle_contour(plan, p[0], p[1])) {
+            result.points.push_back(p);
+        }
     }
-
-    const auto& s0 = kDefaultSensors[tx];
-    const auto& s1 = kDefaultSensors[rx];
-    const double distance = static_cast<double>(sw.distance_m);
-    const double vx0 = std::cos(s0.mounting_rad) * distance;
-    const double vy0 = std::sin(s0.mounting_rad) * distance;
-    const double vx1 = std::cos(s1.mounting_rad) * distance;
-    const double vy1 = std::sin(s1.mounting_rad) * distance;
-
-    double vx = vx0 + vx1;
-    double vy = vy0 + vy1;
-    const double norm = std::sqrt(vx * vx + vy * vy);
-    if (norm > 1.0e-9) {
-        vx = distance * (vx / norm);
-        vy = distance * (vy / norm);
+    if (solution.point_count == 0U && solution.closest_error <= best_limit &&
+        !is_inside_vehicle_contour(plan, solution.closest_point[0], solution.closest_point[1])) {
+        result.points.push_back(solution.closest_point);
     }
-
-    const double cx = 0.5 * (s0.x_m + s1.x_m);
-    const double cy = 0.5 * (s0.y_m + s1.y_m);
-    return {cx + vx, cy + vy};
+    result.deferred_begin = result.points.size();
 }
 
-std::array<double, 2U> fov_detection_from_signal_way(const SignalWay& sw) {
-    const auto tracing = tracing_detection_from_signal_way(sw);
-    return {tracing[0] * 0.98, tracing[1] * 0.98};
-}
+// FOV models share the pair cache with signal-way ellipses under a flagged key.
+constexpr std::uint64_t kFovModelKey = 1ULL << 63U;
 
-double wrap_to_pi(double angle) {
-    while (angle > std::numbers::pi_v<double>) {
-        angle -= 2.0 * std::numbers::pi_v<double>;
-    }
-    while (angle < -std::numbers::pi_v<double>) {
-        angle += 2.0 * std::numbers::pi_v<double>;
-    }
-    return angle;
-}
+// Cross-frame reuse of pair results: `keys` holds one pair_cache_model_key() per model. A null cache disables it.
+struct PairReuse {
+    PairIntersectionCache* cache{nullptr};
+    const std::vector<std::uint64_t>* keys{nullptr};
+};
 
-bool point_in_sensor_sector(const SensorPose& s, const std::array<double, 2U>& p, double range_m) {
-    const double dx = p[0] - s.x_m;
-    const double dy = p[1] - s.y_m;
-    const double r = std::sqrt(dx * dx + dy * dy);
-    if (r > range_m + 1.0e-6) {
-        return false;
-    }
-    const double bearing = std::atan2(dy, dx);
-    const double delta = std::fabs(wrap_to_pi(bearing - s.mounting_rad));
-    return delta <= (0.5 * s.fov_rad + 1.0e-6);
+// Intra-frame fan-out: pair sets of at least `min_pairs` pairs are computed on the pool `pool` returns, which is
+// only asked for once such a set shows up. A null source disables it.
+struct PairParallelism {
+    const std::function<ThreadPool&()>* pool{nullptr};
+    std::size_t min_pairs{0U};
+};
+
+// Pairs per parallel work item. Items never span two first models, so each is sampled once per item at most.
+constexpr std::size_t kPairChunk = 8U;
+
+// Counters post_process() updates; used to fold per-thread counters into the processor's.
+void add_post_process_counters(Diagnostics& into, const Diagnostics& from) {
+    into.skipped_ellipse_pairs += from.skipped_ellipse_pairs;
+    into.pruned_model_pairs += from.pruned_model_pairs;
+    into.visited_model_pairs += from.visited_model_pairs;
+    into.lut_lookups += from.lut_lookups;
+    into.lut_fallbacks += from.lut_fallbacks;
+    into.pair_cache_hits += from.pair_cache_hits;
+    into.pair_cache_misses += from.pair_cache_misses;
+    into.parallel_pair_passes += from.parallel_pair_passes;
 }
 
-bool ray_intersection(const std::array<double, 2U>& p0,
-                      const std::array<double, 2U>& d0,
-                      const std::array<double, 2U>& p1,
-                      const std::array<double, 2U>& d1,
-                      std::array<double, 2U>& out) {
-    const double det = d0[0] * d1[1] - d0[1] * d1[0];
-    if (std::fabs(det) < 1.0e-6) {
-        return false;
+void push_pair_points(const PairIntersections& result,
+                      UniqueDetectionGrid& out,
+                      bool defer_tolerance_hits,
+                      std::vector<std::array<double, 2U>>& deferred) {
+    const auto split = result.points.begin() + static_cast<std::ptrdiff_t>(result.deferred_begin);
+    for (auto it = result.points.begin(); it != split; ++it) {
+        out.push(*it);
     }
-
-    const double px = p1[0] - p0[0];
-    const double py = p1[1] - p0[1];
-    const double t = (px * d1[1] - py * d1[0]) / det;
-    const double u = (px * d0[1] - py * d0[0]) / det;
-    if (t < 0.0 || u < 0.0) {
-        return false;
+    if (defer_tolerance_hits) {
+        deferred.insert(deferred.end(), split, result.points.end());
+    } else {
+        for (auto it = split; it != result.points.end(); ++it) {
+            out.push(*it);
+        }
     }
-
-    out = {p0[0] + t * d0[0], p0[1] + t * d0[1]};
-    return true;
 }
 
-std::optional<std::array<double, 2U>> fov_pie_detection(const SignalWay& sw) {
-    int tx = 0;
-    int rx = 0;
-    if (!map_signal_way_to_sensor_pair(sw.group_id, sw.signal_way_id, tx, rx)) {
-        return std::nullopt;
+// Parallel form of collect_model_pairs(): cache lookups first, then the misses in chunks on the pool (thread
+// `slot` uses ws.pair or pair_workers[slot - 1]), then cache inserts and pushes in pair order. The pushed points
+// are those of the serial loop; only the cache's hit/miss split can differ, as lookups precede this pass's inserts.
+template <typename Compute>
+void compute_model_pairs_parallel(const std::vector<ModelPair>& pairs,
+                                  ProcessorWorkspace& ws,
+                                  const PairReuse& reuse,
+                                  ThreadPool& pool,
+                                  Diagnostics& diagnostics,
+                                  Compute& compute) {
+    auto& results = ws.pair_results;
+    auto& pending = ws.pending_pairs;
+    if (results.size() < pairs.size()) {
+        results.resize(pairs.size());
     }
-    if (tx < 0 || rx < 0 || tx >= static_cast<int>(kDefaultSensors.size()) || rx >= static_cast<int>(kDefaultSensors.size())) {
-        return std::nullopt;
+    pending.clear();
+    for (std::size_t k = 0; k < pairs.size(); ++k) {
+        const PairIntersections* hit = nullptr;
+        if (reuse.cache != nullptr) {
+            hit = reuse.cache->find({(*reuse.keys)[pairs[k].i], (*reuse.keys)[pairs[k].j]});
+            ++(hit != nullptr ? diagnostics.pair_cache_hits : diagnostics.pair_cache_misses);
+        }
+        if (hit != nullptr) {
+            results[k] = *hit;
+        } else {
+            results[k].clear();
+            pending.push_back(k);
+        }
     }
 
-    const auto& s0 = kDefaultSensors[tx];
-    const auto& s1 = kDefaultSensors[rx];
-    const double range_m = static_cast<double>(sw.distance_m);
-    if (range_m <= 0.0) {
-        return std::nullopt;
+    auto& chunks = ws.pair_chunks;
+    chunks.clear();
+    for (std::size_t n = 0; n < pending.size(); ++n) {
+        if (n == 0U || n - chunks.back() == kPairChunk || pairs[pending[n]].i != pairs[pending[n - 1U]].i) {
+            chunks.push_back(n);
+        }
     }
-
-    // Monostatic: detection at the middle of the sensor's FOV arc.
-    if (tx == rx) {
-        return std::array<double, 2U>{
-            s0.x_m + range_m * std::cos(s0.mounting_rad),
-            s0.y_m + range_m * std::sin(s0.mounting_rad)};
+    chunks.push_back(pending.size());
+    ws.pair_workers.resize(pool.concurrency() - 1U);
+    ws.pair.sampled_model = std::numeric_limits<std::size_t>::max();
+    for (auto& worker : ws.pair_workers) {
+        worker.scratch.sampled_model = std::numeric_limits<std::size_t>::max();
     }
-
-    // Bistatic: source location approximated by intersection of both sensors center rays.
-    const std::array<double, 2U> p0{s0.x_m, s0.y_m};
-    const std::array<double, 2U> d0{std::cos(s0.mounting_rad), std::sin(s0.mounting_rad)};
-    const std::array<double, 2U> p1{s1.x_m, s1.y_m};
-    const std::array<double, 2U> d1{std::cos(s1.mounting_rad), std::sin(s1.mounting_rad)};
-    std::array<double, 2U> candidate{};
-    if (ray_intersection(p0, d0, p1, d1, candidate) &&
-        point_in_sensor_sector(s0, candidate, range_m) &&
-        point_in_sensor_sector(s1, candidate, range_m)) {
-        return candidate;
+    pool.parallel_for(chunks.size() - 1U, [&](std::size_t c, std::size_t slot) {
+        PairScratch& scratch = slot == 0U ? ws.pair : ws.pair_workers[slot - 1U].scratch;
+        Diagnostics& counters = slot == 0U ? diagnostics : ws.pair_workers[slot - 1U].diagnostics;
+        for (std::size_t n = chunks[c]; n < chunks[c + 1U]; ++n) {
+            compute(pairs[pending[n]], scratch, counters, results[pending[n]]);
+        }
+    });
+    for (auto& worker : ws.pair_workers) {
+        add_post_process_counters(diagnostics, worker.diagnostics);
+        worker.diagnostics = Diagnostics{};
     }
+    ++diagnostics.parallel_pair_passes;
 
-    // Fallback when center rays don't intersect in valid sectors.
-    return fov_detection_from_signal_way(sw);
+    if (reuse.cache != nullptr) {
+        for (const std::size_t k : pending) {
+            reuse.cache->insert({(*reuse.keys)[pairs[k].i], (*reuse.keys)[pairs[k].j]}, results[k]);
+        }
+    }
 }
 
-void collect_ellipse_intersections(const std::vector<EllipseModel>& models,
-                                   std::vector<std::array<double, 2U>>& out,
-                                   double tolerance,
-                                   double best_limit) {
-    if (models.size() < 2U) {
-        return;
-    }
-    constexpr int kSamples = 360;
-    for (std::size_t i = 0; i + 1U < models.size(); ++i) {
-        for (std::size_t j = i + 1U; j < models.size(); ++j) {
-            double best_err = std::numeric_limits<double>::max();
-            std::array<double, 2U> best_pt{};
-            for (int s = 0; s < kSamples; ++s) {
-                const double t = (static_cast<double>(s) / static_cast<double>(kSamples)) *
-                                 (2.0 * std::numbers::pi_v<double>);
-                const auto p = ellipse_point(models[i], t);
-                const double err = ellipse_implicit_error(models[j], p[0], p[1]);
-                if (err < best_err) {
-                    best_err = err;
-                    best_pt = p;
-                }
-                if (err <= tolerance && !is_inside_vehicle_contour(p[0], p[1])) {
-                    push_unique_detection(out, p);
-                }
+// Visits every pair once, taking its points from the cache when present and from `compute` otherwise, and pushes
+// them in visiting order. With `defer_tolerance_hits` each pair's deferred points wait until every pair has been
+// visited, reproducing the order of a full traverse pass followed by a full tolerance pass.
+template <typename Compute>
+void collect_model_pairs(const std::vector<ModelPair>& pairs,
+                         ProcessorWorkspace& ws,
+                         UniqueDetectionGrid& out,
+                         bool defer_tolerance_hits,
+                         const PairReuse& reuse,
+                         const PairParallelism& parallel,
+                         Diagnostics& diagnostics,
+                         Compute&& compute) {
+    auto& deferred = ws.deferred_hits;
+    deferred.clear();
+    if (parallel.pool != nullptr && *parallel.pool && parallel.min_pairs > 0U && pairs.size() >= parallel.min_pairs) {
+        compute_model_pairs_parallel(pairs, ws, reuse, (*parallel.pool)(), diagnostics, compute);
+        for (std::size_t k = 0; k < pairs.size(); ++k) {
+            push_pair_points(ws.pair_results[k], out, defer_tolerance_hits, deferred);
+        }
+    } else {
+        ws.pair.sampled_model = std::numeric_limits<std::size_t>::max();
+        for (const auto& pair : pairs) {
+            const PairIntersections* result = nullptr;
+            PairCacheKey key;
+            if (reuse.cache != nullptr) {
+                key = {(*reuse.keys)[pair.i], (*reuse.keys)[pair.j]};
+                result = reuse.cache->find(key);
+                ++(result != nullptr ? diagnostics.pair_cache_hits : diagnostics.pair_cache_misses);
             }
-            if (best_err <= best_limit && !is_inside_vehicle_contour(best_pt[0], best_pt[1])) {
-                push_unique_detection(out, best_pt);
+            if (result == nullptr) {
+                ws.pair_result.clear();
+                compute(pair, ws.pair, diagnostics, ws.pair_result);
+                if (reuse.cache != nullptr) {
+                    reuse.cache->insert(key, ws.pair_result);
+                }
+                result = &ws.pair_result;
             }
+            push_pair_points(*result, out, defer_tolerance_hits, deferred);
         }
     }
+    for (const auto& p : deferred) {
+        out.push(p);
+    }
 }
 
-double ellipse_implicit_value(const EllipseModel& e, double x_m, double y_m) {
-    const double dx = x_m - e.cx;
-    const double dy = y_m - e.cy;
-    const double cp = std::cos(e.theta);
-    const double sp = std::sin(e.theta);
-    const double xr = dx * cp + dy * sp;
-    const double yr = -dx * sp + dy * cp;
-    return sqr(xr) / std::max(sqr(e.axis_a), 1.0e-9) + sqr(yr) / std::max(sqr(e.axis_b), 1.0e-9) - 1.0;
+template <typename Solver>
+void collect_solved_pairs(const GeometryPlan& plan,
+                          const std::vector<PreparedEllipse>& models,
+                          const std::vector<ModelPair>& pairs,
+                          ProcessorWorkspace& ws,
+                          UniqueDetectionGrid& out,
+                          double tolerance,
+                          double best_limit,
+                          const PairReuse& reuse,
+                          const PairParallelism& parallel,
+                          Diagnostics& diagnostics,
+                          Solver&& solve) {
+    collect_model_pairs(pairs, ws, out, false, reuse, parallel, diagnostics,
+                        [&](const ModelPair& pair, PairScratch& scratch, Diagnostics& counters, PairIntersections& result) {
+                            collect_pair_solved(plan, models, pair, scratch, counters, tolerance, best_limit, solve,
+                                                result);
+                        });
 }
 
-// Legacy-style traverse approximation: march along one ellipse and locate sign changes w.r.t. the other implicit equation.
-void collect_ellipse_intersections_traverse(const std::vector<EllipseModel>& models,
-                                            std::vector<std::array<double, 2U>>& out) {
-    if (models.size() < 2U) {
-        return;
-    }
+// Sampled path. Pairs arrive grouped by their first model, which is sampled once (on the first pair the cache
+// does not answer) and evaluated against each partner. With `traverse`, the legacy-style traverse approximation
+// (sign changes of the other implicit equation along each ellipse) runs in the same pass as the tolerance sweep.
+void collect_sampled_pairs(const GeometryPlan& plan,
+                           const std::vector<PreparedEllipse>& models,
+                           const std::vector<ModelPair>& pairs,
+                           ProcessorWorkspace& ws,
+                           UniqueDetectionGrid& out,
+                           double tolerance,
+                           double best_limit,
+                           bool traverse,
+                           const PairReuse& reuse,
+                           const PairParallelism& parallel,
+                           Diagnostics& diagnostics) {
+    collect_model_pairs(
+        pairs, ws, out, traverse, reuse, parallel, diagnostics,
+        [&](const ModelPair& pair, PairScratch& scratch, Diagnostics& /*counters*/, PairIntersections& result) {
+            sample_model(models, pair.i, scratch);
+            if (traverse) {
+                collect_pair_fused(plan, models[pair.i], scratch.samples, models[pair.j], scratch, tolerance, best_limit,
+                                   result);
+            } else {
+                collect_pair_tolerance_hits(plan, scratch.samples, models[pair.j], scratch, tolerance, best_limit, result);
+            }
+        });
+}
 
-    constexpr int kSamples = 360;
-    for (std::size_t i = 0; i + 1U < models.size(); ++i) {
-        for (std::size_t j = i + 1U; j < models.size(); ++j) {
-            double prev_t = 0.0;
-            auto prev_p = ellipse_point(models[i], prev_t);
-            double prev_v = ellipse_implicit_value(models[j], prev_p[0], prev_p[1]);
-
-            for (int s = 1; s <= kSamples; ++s) {
-                const double t = (static_cast<double>(s) / static_cast<double>(kSamples)) *
-                                 (2.0 * std::numbers::pi_v<double>);
-                const auto p = ellipse_point(models[i], t);
-                const double v = ellipse_implicit_value(models[j], p[0], p[1]);
-
-                if ((prev_v <= 0.0 && v >= 0.0) || (prev_v >= 0.0 && v <= 0.0)) {
-                    double lo = prev_t;
-                    double hi = t;
-                    for (int it = 0; it < 20; ++it) {
-                        const double mid = 0.5 * (lo + hi);
-                        const auto mid_p = ellipse_point(models[i], mid);
-                        const double mid_v = ellipse_implicit_value(models[j], mid_p[0], mid_p[1]);
-                        if ((prev_v <= 0.0 && mid_v >= 0.0) || (prev_v >= 0.0 && mid_v <= 0.0)) {
-                            hi = mid;
-                        } else {
-                            lo = mid;
-                            prev_v = mid_v;
-                        }
-                    }
-                    const auto root_p = ellipse_point(models[i], 0.5 * (lo + hi));
-                    if (!is_inside_vehicle_contour(root_p[0], root_p[1])) {
-                        push_unique_detection(out, root_p);
-                    }
-                }
+void collect_model_intersections(IntersectionSolver solver,
+                                 const GeometryPlan& plan,
+                                 const std::vector<PreparedEllipse>& models,
+                                 const std::vector<ModelPair>& pairs,
+                                 ProcessorWorkspace& ws,
+                                 UniqueDetectionGrid& out,
+                                 double tolerance,
+                                 double best_limit,
+                                 bool traverse,
+                                 const PairReuse& reuse,
+                                 const PairParallelism& parallel,
+                                 Diagnostics& diagnostics) {
+    switch (solver) {
+        case IntersectionSolver::Analytic:
+        case IntersectionSolver::Lookup:
+            collect_solved_pairs(plan, models, pairs, ws, out, tolerance, best_limit, reuse, parallel, diagnostics,
+                                 [&models](const ModelPair& pair, Diagnostics& /*counters*/, EllipsePairSolution& solution) {
+                                     return solve_ellipse_intersections(models[pair.i].model, models[pair.j].model,
+                                                                        solution);
+                                 });
+            break;
+        case IntersectionSolver::Adaptive:
+            collect_solved_pairs(plan, models, pairs, ws, out, tolerance, best_limit, reuse, parallel, diagnostics,
+                                 [&models](const ModelPair& pair, Diagnostics& /*counters*/, EllipsePairSolution& solution) {
+                                     return adaptive_ellipse_intersections(models[pair.i], models[pair.j], solution);
+                                 });
+            break;
+        case IntersectionSolver::Sampled:
+            collect_sampled_pairs(plan, models, pairs, ws, out, tolerance, best_limit, traverse, reuse, parallel,
+                                  diagnostics);
+            break;
+    }
+}
 
-                prev_t = t;
-                prev_p = p;
-                prev_v = v;
+// Table lookup per ellipse pair (optionally Newton-polished); cells the table cannot answer, and roots the
+// polish cannot settle, go to the closed-form solver. The range of a signal-way ellipse is its axis_a.
+void collect_ellipse_intersections_lookup(const GeometryPlan& plan,
+                                          const IntersectionLut& lut,
+                                          const std::vector<PreparedEllipse>& models,
+                                          const std::vector<ModelOrigin>& origins,
+                                          const std::vector<ModelPair>& pairs,
+                                          bool polish,
+                                          ProcessorWorkspace& ws,
+                                          UniqueDetectionGrid& out,
+                                          const PairReuse& reuse,
+                                          const PairParallelism& parallel,
+                                          Diagnostics& diagnostics) {
+    collect_solved_pairs(
+        plan, models, pairs, ws, out, 0.08, 0.2, reuse, parallel, diagnostics,
+        [&](const ModelPair& pair, Diagnostics& counters, EllipsePairSolution& solution) {
+            const auto& a = models[pair.i];
+            const auto& b = models[pair.j];
+            bool answered =
+                lookup_intersections(lut, origins[pair.i], a.model.axis_a, origins[pair.j], b.model.axis_a, solution);
+            for (std::size_t k = 0; polish && answered && k < solution.point_count; ++k) {
+                answered = polish_intersection(a, b, solution.points[k]);
             }
-        }
-    }
+            if (!answered) {
+                ++counters.lut_fallbacks;
+                return solve_ellipse_intersections(a.model, b.model, solution);
+            }
+            ++counters.lut_lookups;
+            solution.closest_point = solution.points[0];
+            return true;
+        });
 }
 
-double point_distance_sq(const std::array<double, 2U>& a, const std::array<double, 2U>& b) {
-    return sqr(a[0] - b[0]) + sqr(a[1] - b[1]);
+std::uint64_t elapsed_us(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
 }
 
-bool has_support_near(const std::vector<std::array<double, 2U>>& detections,
-                      const std::array<double, 2U>& candidate,
-                      double radius_m) {
-    const double radius_sq = radius_m * radius_m;
-    for (const auto& p : detections) {
-        if (point_distance_sq(p, candidate) <= radius_sq) {
-            return true;
-        }
-    }
-    return false;
+constexpr std::uint8_t kTracingBit = 1U << 0U;
+constexpr std::uint8_t kFovBit = 1U << 1U;
+constexpr std::uint8_t kEllipseBit = 1U << 2U;
+
+int count_methods(std::uint8_t mask) {
+    return ((mask & kTracingBit) != 0U ? 1 : 0) + ((mask & kFovBit) != 0U ? 1 : 0) + ((mask & kEllipseBit) != 0U ? 1 : 0);
 }
 
-std::vector<std::array<double, 2U>> fuse_method_detections(const ProcessedDetections& in) {
-    std::vector<std::array<double, 2U>> candidates;
-    candidates.reserve(in.tracing.size() + in.fov_intersections.size() + in.ellipse_intersections.size());
+void fuse_method_detections(const ProcessedDetections& in,
+                            ProcessorWorkspace& ws,
+                            std::vector<std::array<double, 2U>>& fused) {
+    auto& candidates = ws.fusion_candidates;
+    auto& unique_candidates = ws.unique_detections;
+    auto& unique_fused = ws.unique_fused;
+    candidates.clear();
+    unique_candidates.attach(candidates);
     for (const auto& p : in.tracing) {
-        push_unique_detection(candidates, p);
+        unique_candidates.push(p);
     }
     for (const auto& p : in.fov_intersections) {
-        push_unique_detection(candidates, p);
+        unique_candidates.push(p);
     }
     for (const auto& p : in.ellipse_intersections) {
-        push_unique_detection(candidates, p);
+        unique_candidates.push(p);
     }
 
     const bool has_tracing = !in.tracing.empty();
     const bool has_fov = !in.fov_intersections.empty();
     const bool has_ellipse = !in.ellipse_intersections.empty();
-    const int available_methods = (has_tracing ? 1 : 0) + (has_fov ? 1 : 0) + (has_ellipse ? 1 : 0);
+    const auto available_mask = static_cast<std::uint8_t>((has_tracing ? kTracingBit : 0U) | (has_fov ? kFovBit : 0U) |
+                                                          (has_ellipse ? kEllipseBit : 0U));
+    const int available_methods = count_methods(available_mask);
 
-    std::vector<std::array<double, 2U>> fused;
-    fused.reserve(candidates.size());
+    fused.clear();
+    unique_fused.attach(fused);
 
     // FOV acts as existence verification for other methods when available.
-    constexpr double kSupportRadiusM = 0.55;
-    for (const auto& c : candidates) {
-        const bool support_tracing = has_support_near(in.tracing, c, kSupportRadiusM);
-        const bool support_fov = has_support_near(in.fov_intersections, c, kSupportRadiusM);
-        const bool support_ellipse = has_support_near(in.ellipse_intersections, c, kSupportRadiusM);
-        const int support_count = (support_tracing ? 1 : 0) + (support_fov ? 1 : 0) + (support_ellipse ? 1 : 0);
-
-        if (available_methods <= 1) {
-            push_unique_detection(fused, c);
-            continue;
+    if (available_methods <= 1) {
+        for (const auto& c : candidates) {
+            unique_fused.push(c);
         }
-
-        if (support_count >= 2) {
-            push_unique_detection(fused, c);
+    } else {
+        auto& support = ws.method_support;
+        support.clear(in.tracing.size() + in.fov_intersections.size() + in.ellipse_intersections.size());
+        support.insert_all(in.tracing, kTracingBit);
+        support.insert_all(in.fov_intersections, kFovBit);
+        support.insert_all(in.ellipse_intersections, kEllipseBit);
+        for (const auto& c : candidates) {
+            if (count_methods(support.support_mask(c, available_mask)) >= 2) {
+                unique_fused.push(c);
+            }
         }
     }
 
@@ -537,111 +496,232 @@ std::vector<std::array<double, 2U>> fuse_method_detections(const ProcessedDetect
     if (fused.empty()) {
         if (has_fov) {
             for (const auto& p : in.fov_intersections) {
-                push_unique_detection(fused, p);
+                unique_fused.push(p);
             }
         }
         if (fused.empty() && has_ellipse) {
             for (const auto& p : in.ellipse_intersections) {
-                push_unique_detection(fused, p);
+                unique_fused.push(p);
             }
         }
         if (fused.empty() && has_tracing) {
             for (const auto& p : in.tracing) {
-                push_unique_detection(fused, p);
+                unique_fused.push(p);
             }
         }
     }
-
-    return fused;
 }
 
-std::vector<std::array<double, 2U>> cluster_with_table_melt(const std::vector<std::array<double, 2U>>& in, double radius_m) {
-    std::vector<std::array<double, 2U>> clustered;
-    if (in.empty()) {
-        return clustered;
+}  // namespace
+
+UltrasoundProcessor::UltrasoundProcessor(ProcessorConfig config)
+    : UltrasoundProcessor(config, default_geometry_plan()) {}
+
+UltrasoundProcessor::UltrasoundProcessor(ProcessorConfig config, const VehicleGeometry& geometry)
+    : UltrasoundProcessor(config, compile_geometry_plan(geometry)) {}
+
+UltrasoundProcessor::UltrasoundProcessor(ProcessorConfig config, std::shared_ptr<const GeometryPlan> plan)
+    : UltrasoundProcessor(std::move(config), std::move(plan), nullptr) {}
+
+UltrasoundProcessor::UltrasoundProcessor(ProcessorConfig config,
+                                         std::shared_ptr<const GeometryPlan> plan,
+                                         std::shared_ptr<const IntersectionLut> lut)
+    : config_(std::move(config)),
+      plan_(plan != nullptr ? std::move(plan) : default_geometry_plan()),
+      lut_(std::move(lut)),
+      pair_cache_(config_.pair_cache_capacity),
+      state_channel_(std::make_unique<VehicleStateChannel>(config_.vehicle_state_channel_capacity)) {
+    if (config_.intersection_solver != IntersectionSolver::Lookup) {
+        lut_.reset();
+        return;
     }
+    const auto min_range = static_cast<double>(config_.min_range_m);
+    const auto max_range = static_cast<double>(config_.max_range_m);
+    if (lut_ == nullptr || !intersection_lut_matches(*lut_, *plan_, min_range, max_range, config_.lut_resolution)) {
+        lut_ = build_intersection_lut(*plan_, min_range, max_range, config_.lut_resolution);
+    }
+}
 
-    const double radius_sq = radius_m * radius_m;
-    const std::size_t n = in.size();
-    std::vector<std::vector<std::uint8_t>> adjacency(n, std::vector<std::uint8_t>(n, 0U));
-    for (std::size_t i = 0; i < n; ++i) {
-        adjacency[i][i] = 1U;
-        for (std::size_t j = i + 1U; j < n; ++j) {
-            const double dx = in[j][0] - in[i][0];
-            const double dy = in[j][1] - in[i][1];
-            if ((dx * dx + dy * dy) <= radius_sq) {
-                adjacency[i][j] = 1U;
-                adjacency[j][i] = 1U;
-            }
-        }
+Status UltrasoundProcessor::push_vehicle_state(const VehicleState& state) {
+    if (!state_queue_.empty() && state.timestamp_us <= state_queue_.back().timestamp_us) {
+        return Status::fail(ErrorCode::InvalidInput, "vehicle state timestamps must be monotonic");
     }
 
-    std::vector<int> cluster_id(n, 0);
-    int next_id = 1;
-    for (std::size_t i = 0; i < n; ++i) {
-        if (cluster_id[i] != 0) {
-            continue;
-        }
-        cluster_id[i] = next_id;
-        bool changed = true;
-        while (changed) {
-            changed = false;
-            for (std::size_t a = 0; a < n; ++a) {
-                if (cluster_id[a] != next_id) {
-                    continue;
-                }
-                for (std::size_t b = 0; b < n; ++b) {
-                    if (adjacency[a][b] != 0U && cluster_id[b] == 0) {
-                        cluster_id[b] = next_id;
-                        changed = true;
-                    }
-                }
-            }
-        }
-        ++next_id;
+    state_queue_.push_back(state);
+    while (state_queue_.size() > kMaxVehicleStates) {
+        state_queue_.pop_front();
     }
+    return Status::ok();
+}
 
-    std::unordered_map<int, std::array<double, 3U>> accum;
-    for (std::size_t i = 0; i < n; ++i) {
-        auto& a = accum[cluster_id[i]];
-        a[0] += in[i][0];
-        a[1] += in[i][1];
-        a[2] += 1.0;
+bool UltrasoundProcessor::offer_vehicle_state(const VehicleState& state) {
+    if (!state_channel_->ring.try_push(state)) {
+        state_channel_->overflows.fetch_add(1U, std::memory_order_relaxed);
+        return false;
     }
+    return true;
+}
 
-    clustered.reserve(accum.size());
-    for (int cid = 1; cid < next_id; ++cid) {
-        const auto it = accum.find(cid);
-        if (it == accum.end() || it->second[2] <= 0.0) {
-            continue;
+std::uint64_t UltrasoundProcessor::vehicle_state_overflows() const {
+    return state_channel_->overflows.load(std::memory_order_relaxed);
+}
+
+void UltrasoundProcessor::drain_vehicle_states() {
+    VehicleState state;
+    while (state_channel_->ring.try_pop(state)) {
+        if (!push_vehicle_state(state).is_ok()) {
+            ++diagnostics_.rejected_vehicle_states;
         }
-        clustered.push_back({it->second[0] / it->second[2], it->second[1] / it->second[2]});
     }
-    return clustered;
 }
 
-}  // namespace
+Status UltrasoundProcessor::process_frame(const FrameInput& input) {
+    return run_frame(input, nullptr, nullptr);
+}
 
-UltrasoundProcessor::UltrasoundProcessor(ProcessorConfig config)
-    : config_(config) {}
+Status UltrasoundProcessor::process_frame(const FrameInput& input, FrameOutput& output) {
+    return run_frame(input, nullptr, &output);
+}
 
-Status UltrasoundProcessor::push_vehicle_state(const VehicleState& state) {
-    if (!state_queue_.empty() && state.timestamp_us <= state_queue_.back().timestamp_us) {
-        return Status::fail(ErrorCode::InvalidInput, "vehicle state timestamps must be monotonic");
+Status UltrasoundProcessor::process_frame(FrameInput&& input) {
+    return run_frame(input, &input, nullptr);
+}
+
+Status UltrasoundProcessor::process_frame(FrameInput&& input, FrameOutput& output) {
+    return run_frame(input, &input, &output);
+}
+
+Status UltrasoundProcessor::run_frame(const FrameInput& input, FrameInput* consumed, FrameOutput* caller_output) {
+    diagnostics_.last_stage_timing_us = {};
+    StageTimingUs timing;
+    Pose2d pose;
+    if (const auto status = admit_frame(input, pose, timing); !status.is_ok()) {
+        return status;
     }
 
-    state_queue_.push_back(state);
-    constexpr std::size_t kMaxQueue = 64U;
-    while (state_queue_.size() > kMaxQueue) {
-        state_queue_.pop_front();
+    const auto t_convert_start = std::chrono::steady_clock::now();
+    // Retained frames are written straight into last_output_, reusing its buffers from the previous frame.
+    FrameOutput& output = caller_output != nullptr ? *caller_output
+                          : last_output_.has_value() ? *last_output_
+                                                     : last_output_.emplace();
+    convert_frame(input, consumed, pose, output);
+    timing.convert = elapsed_us(t_convert_start, std::chrono::steady_clock::now());
+
+    const auto t_postprocess_start = std::chrono::steady_clock::now();
+    const bool reuse = matches_previous_frame(output.signal_ways);
+    if (!reuse) {
+        has_previous_detections_ = config_.reuse_unchanged_frames;
     }
+    post_process_frame(output, reuse, diagnostics_);
+    timing.postprocess = elapsed_us(t_postprocess_start, std::chrono::steady_clock::now());
+
+    publish_frame(output, timing, diagnostics_);
     return Status::ok();
 }
 
-Status UltrasoundProcessor::process_frame(const FrameInput& input) {
-    const auto t0 = std::chrono::steady_clock::now();
-    diagnostics_.last_stage_timing_us = {};
+void UltrasoundProcessor::post_process_frame(FrameOutput& output, bool reuse, Diagnostics& diagnostics) {
+    if (reuse) {
+        output.processed = previous_detections_;
+        ++diagnostics.reused_frames;
+        return;
+    }
+    // Without background threads a parallel pass would run on this thread anyway, so no pool is made for it.
+    PairPoolSource pair_pool{};
+    if (config_.parallel_pair_threshold > 0U && background_threads_for(config_.worker_threads) > 0U) {
+        pair_pool = [this]() -> ThreadPool& { return thread_pool(); };
+    }
+    post_process(output.signal_ways, output.processed, workspace_, pair_cache_, diagnostics, pair_pool);
+    if (config_.reuse_unchanged_frames) {
+        previous_detections_ = output.processed;
+    }
+}
+
+Status UltrasoundProcessor::process_frames(std::span<const FrameInput> inputs,
+                                           std::vector<FrameOutput>& outputs,
+                                           std::vector<Status>& statuses) {
+    constexpr std::size_t kDropped = std::numeric_limits<std::size_t>::max();
+    constexpr std::size_t kPreviousBatch = kDropped - 1U;
+    outputs.resize(inputs.size());
+    statuses.assign(inputs.size(), Status::ok());
+    auto& batch = batch_;
+    batch.sources.assign(inputs.size(), kDropped);
+    batch.timings.assign(inputs.size(), StageTimingUs{});
+    batch.computed.clear();
+    Status result = Status::ok();
+
+    // Ordered stages: admission (monotonic timestamps, pose), filtering and the reuse decision. A reused frame
+    // points at the frame it copies, which may still have to be computed.
+    std::size_t last_computed = kPreviousBatch;
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        Pose2d pose;
+        statuses[i] = admit_frame(inputs[i], pose, batch.timings[i]);
+        if (!statuses[i].is_ok()) {
+            if (result.is_ok()) {
+                result = statuses[i];
+            }
+            continue;
+        }
+        const auto t_convert_start = std::chrono::steady_clock::now();
+        convert_frame(inputs[i], nullptr, pose, outputs[i]);
+        batch.timings[i].convert = elapsed_us(t_convert_start, std::chrono::steady_clock::now());
+        if (matches_previous_frame(outputs[i].signal_ways)) {
+            batch.sources[i] = last_computed;
+            continue;
+        }
+        batch.sources[i] = i;
+        batch.computed.push_back(i);
+        last_computed = i;
+        has_previous_detections_ = config_.reuse_unchanged_frames;
+    }
 
+    // post_process() depends only on the frame's signal ways, so frames run on any thread; each thread has its
+    // own workspace, pair cache and counters. Pair-cache hit counts therefore depend on the thread count. The
+    // pool is busy with whole frames, so pairs are not split further.
+    auto& pool = thread_pool();
+    batch.workers.resize(pool.concurrency() - 1U);
+    for (auto& worker : batch.workers) {
+        if (worker.pair_cache.capacity() != pair_cache_.capacity()) {
+            worker.pair_cache = PairIntersectionCache(pair_cache_.capacity());
+        }
+        worker.diagnostics = Diagnostics{};
+    }
+    pool.parallel_for(batch.computed.size(), [&](std::size_t k, std::size_t slot) {
+        const std::size_t i = batch.computed[k];
+        const auto t_postprocess_start = std::chrono::steady_clock::now();
+        if (slot == 0U) {
+            post_process(outputs[i].signal_ways, outputs[i].processed, workspace_, pair_cache_, diagnostics_,
+                         PairPoolSource{});
+        } else {
+            auto& worker = batch.workers[slot - 1U];
+            post_process(outputs[i].signal_ways, outputs[i].processed, worker.workspace, worker.pair_cache,
+                         worker.diagnostics, PairPoolSource{});
+        }
+        batch.timings[i].postprocess = elapsed_us(t_postprocess_start, std::chrono::steady_clock::now());
+    });
+    for (const auto& worker : batch.workers) {
+        add_post_process_counters(diagnostics_, worker.diagnostics);
+    }
+
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        const std::size_t source = batch.sources[i];
+        if (source == kDropped) {
+            continue;
+        }
+        if (source != i) {
+            outputs[i].processed = source == kPreviousBatch ? previous_detections_ : outputs[source].processed;
+            ++diagnostics_.reused_frames;
+        }
+        publish_frame(outputs[i], batch.timings[i], diagnostics_);
+    }
+    if (last_computed != kPreviousBatch && config_.reuse_unchanged_frames) {
+        previous_detections_ = outputs[last_computed].processed;
+    }
+    return result;
+}
+
+Status UltrasoundProcessor::admit_frame(const FrameInput& input, Pose2d& pose, StageTimingUs& timing) {
+    const auto t0 = std::chrono::steady_clock::now();
+    drain_vehicle_states();
     if (config_.strict_monotonic_timestamps && input.timestamp_us <= last_timestamp_us_) {
         ++diagnostics_.dropped_frames;
         ++diagnostics_.out_of_order_frames;
@@ -656,79 +736,121 @@ Status UltrasoundProcessor::process_frame(const FrameInput& input) {
     const auto t_decode_end = std::chrono::steady_clock::now();
 
     const auto t_interpolate_start = std::chrono::steady_clock::now();
-    const auto pose = interpolate_pose(input.timestamp_us);
-    if (!pose.has_value()) {
+    const auto interpolated = interpolate_pose(input.timestamp_us);
+    if (!interpolated.has_value()) {
         ++diagnostics_.dropped_frames;
         ++diagnostics_.missing_state_frames;
         return Status::fail(ErrorCode::MissingVehicleState, "no vehicle state available for frame");
     }
-    const auto t_interpolate_end = std::chrono::steady_clock::now();
+    pose = *interpolated;
+    // Nothing after admission can fail, so the frame counts as accepted for the monotonic check from here on.
+    last_timestamp_us_ = input.timestamp_us;
+    timing.decode = elapsed_us(t0, t_decode_end);
+    timing.interpolate = elapsed_us(t_interpolate_start, std::chrono::steady_clock::now());
+    return Status::ok();
+}
 
-    const auto t_convert_start = std::chrono::steady_clock::now();
-    FrameOutput output;
+void UltrasoundProcessor::convert_frame(const FrameInput& input,
+                                        FrameInput* consumed,
+                                        const Pose2d& pose,
+                                        FrameOutput& output) {
     output.timestamp_us = input.timestamp_us;
-    output.observation_pose = *pose;
-
-    for (const auto& sw : input.signal_ways) {
-        const bool range_ok = sw.distance_m > config_.min_range_m && sw.distance_m <= config_.max_range_m;
-        const bool group_ok = group_matches(config_.group_filter, sw.group_id);
-        if (range_ok && group_ok) {
-            output.signal_ways.push_back(sw);
-        } else {
-            ++diagnostics_.filtered_signal_ways;
+    output.observation_pose = pose;
+    if (consumed != nullptr) {
+        // Compact the handed-over buffers in place (std::remove_if keeps order) and swap them into the
+        // output; the caller gets the output's previous buffers back for reuse instead of a copy.
+        auto& sws = consumed->signal_ways;
+        sws.erase(std::remove_if(sws.begin(), sws.end(),
+                                 [this](const SignalWay& sw) {
+                                     const bool range_ok =
+                                         sw.distance_m > config_.min_range_m && sw.distance_m <= config_.max_range_m;
+                                     if (range_ok && group_matches(config_.group_filter, sw.group_id)) {
+                                         return false;
+                                     }
+                                     ++diagnostics_.filtered_signal_ways;
+                                     return true;
+                                 }),
+                  sws.end());
+        const auto invalid = [](const auto& feature) { return !feature.valid; };
+        auto& sfs = consumed->static_features;
+        sfs.erase(std::remove_if(sfs.begin(), sfs.end(), invalid), sfs.end());
+        auto& dfs = consumed->dynamic_features;
+        dfs.erase(std::remove_if(dfs.begin(), dfs.end(), invalid), dfs.end());
+        auto& lms = consumed->line_marks;
+        lms.erase(std::remove_if(lms.begin(), lms.end(), invalid), lms.end());
+
+        std::swap(output.signal_ways, sws);
+        std::swap(output.static_features, sfs);
+        std::swap(output.dynamic_features, dfs);
+        std::swap(output.line_marks, lms);
+        std::swap(output.grid_map, consumed->grid_map);
+    } else {
+        output.signal_ways.clear();
+        output.static_features.clear();
+        output.dynamic_features.clear();
+        output.line_marks.clear();
+
+        for (const auto& sw : input.signal_ways) {
+            const bool range_ok = sw.distance_m > config_.min_range_m && sw.distance_m <= config_.max_range_m;
+            const bool group_ok = group_matches(config_.group_filter, sw.group_id);
+            if (range_ok && group_ok) {
+                output.signal_ways.push_back(sw);
+            } else {
+                ++diagnostics_.filtered_signal_ways;
+            }
         }
-    }
 
-    for (const auto& sf : input.static_features) {
-        if (sf.valid) {
-            output.static_features.push_back(sf);
+        for (const auto& sf : input.static_features) {
+            if (sf.valid) {
+                output.static_features.push_back(sf);
+            }
         }
-    }
-    for (const auto& df : input.dynamic_features) {
-        if (df.valid) {
-            output.dynamic_features.push_back(df);
+        for (const auto& df : input.dynamic_features) {
+            if (df.valid) {
+                output.dynamic_features.push_back(df);
+            }
         }
-    }
-    for (const auto& lm : input.line_marks) {
-        if (lm.valid) {
-            output.line_marks.push_back(lm);
+        for (const auto& lm : input.line_marks) {
+            if (lm.valid) {
+                output.line_marks.push_back(lm);
+            }
         }
+        output.grid_map = input.grid_map;
     }
-    output.grid_map = input.grid_map;
-    const auto t_convert_end = std::chrono::steady_clock::now();
-
-    const auto t_postprocess_start = std::chrono::steady_clock::now();
-    output.processed = post_process(output.signal_ways);
-    const auto t_postprocess_end = std::chrono::steady_clock::now();
+}
 
+void UltrasoundProcessor::publish_frame(const FrameOutput& output, StageTimingUs& timing, Diagnostics& diagnostics) {
     const auto t_publish_start = std::chrono::steady_clock::now();
-    last_output_ = output;
-    last_timestamp_us_ = input.timestamp_us;
-    ++diagnostics_.processed_frames;
-    diagnostics_.clustered_detections += output.processed.clustered.size();
-    const auto t_publish_end = std::chrono::steady_clock::now();
-
-    diagnostics_.last_stage_timing_us.decode =
-        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(t_decode_end - t0).count());
-    diagnostics_.last_stage_timing_us.interpolate = static_cast<std::uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(t_interpolate_end - t_interpolate_start).count());
-    diagnostics_.last_stage_timing_us.convert = static_cast<std::uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(t_convert_end - t_convert_start).count());
-    diagnostics_.last_stage_timing_us.postprocess = static_cast<std::uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(t_postprocess_end - t_postprocess_start).count());
-    diagnostics_.last_stage_timing_us.publish = static_cast<std::uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(t_publish_end - t_publish_start).count());
-
-    diagnostics_.cumulative_stage_timing_us.decode += diagnostics_.last_stage_timing_us.decode;
-    diagnostics_.cumulative_stage_timing_us.interpolate += diagnostics_.last_stage_timing_us.interpolate;
-    diagnostics_.cumulative_stage_timing_us.convert += diagnostics_.last_stage_timing_us.convert;
-    diagnostics_.cumulative_stage_timing_us.postprocess += diagnostics_.last_stage_timing_us.postprocess;
-    diagnostics_.cumulative_stage_timing_us.publish += diagnostics_.last_stage_timing_us.publish;
+    ++diagnostics.processed_frames;
+    diagnostics.clustered_detections += output.processed.clustered.size();
+    timing.publish = elapsed_us(t_publish_start, std::chrono::steady_clock::now());
+
+    diagnostics.last_stage_timing_us = timing;
+    diagnostics.cumulative_stage_timing_us.decode += timing.decode;
+    diagnostics.cumulative_stage_timing_us.interpolate += timing.interpolate;
+    diagnostics.cumulative_stage_timing_us.convert += timing.convert;
+    diagnostics.cumulative_stage_timing_us.postprocess += timing.postprocess;
+    diagnostics.cumulative_stage_timing_us.publish += timing.publish;
+}
 
-    return Status::ok();
+// Publish-stage counters are folded in as well; the last stage timing is taken when `from` published a frame.
+void UltrasoundProcessor::absorb_stage_diagnostics(const Diagnostics& from) {
+    add_post_process_counters(diagnostics_, from);
+    diagnostics_.reused_frames += from.reused_frames;
+    diagnostics_.processed_frames += from.processed_frames;
+    diagnostics_.clustered_detections += from.clustered_detections;
+    if (from.processed_frames > 0U) {
+        diagnostics_.last_stage_timing_us = from.last_stage_timing_us;
+    }
+    auto& into = diagnostics_.cumulative_stage_timing_us;
+    into.decode += from.cumulative_stage_timing_us.decode;
+    into.interpolate += from.cumulative_stage_timing_us.interpolate;
+    into.convert += from.cumulative_stage_timing_us.convert;
+    into.postprocess += from.cumulative_stage_timing_us.postprocess;
+    into.publish += from.cumulative_stage_timing_us.publish;
 }
 
-std::optional<FrameOutput> UltrasoundProcessor::last_output() const {
+const std::optional<FrameOutput>& UltrasoundProcessor::last_output() const {
     return last_output_;
 }
 
@@ -736,6 +858,21 @@ Diagnostics UltrasoundProcessor::diagnostics() const {
     return diagnostics_;
 }
 
+const std::shared_ptr<const GeometryPlan>& UltrasoundProcessor::geometry_plan() const {
+    return plan_;
+}
+
+ThreadPool& UltrasoundProcessor::thread_pool() {
+    if (pool_ == nullptr) {
+        pool_ = std::make_shared<ThreadPool>(background_threads_for(config_.worker_threads));
+    }
+    return *pool_;
+}
+
+const std::shared_ptr<const IntersectionLut>& UltrasoundProcessor::intersection_lut() const {
+    return lut_;
+}
+
 std::optional<Pose2d> UltrasoundProcessor::interpolate_pose(std::uint64_t timestamp_us) const {
     if (state_queue_.empty()) {
         return std::nullopt;
@@ -767,59 +904,148 @@ std::optional<Pose2d> UltrasoundProcessor::interpolate_pose(std::uint64_t timest
     return std::nullopt;
 }
 
-ProcessedDetections UltrasoundProcessor::post_process(const std::vector<SignalWay>& signal_ways) const {
-    ProcessedDetections out;
-    std::vector<EllipseModel> ellipses;
-    std::vector<EllipseModel> fov_models;
-    ellipses.reserve(signal_ways.size());
-    fov_models.reserve(signal_ways.size());
+// The frame key is the arrival-ordered list of model keys, not a hash, so a match is never a collision. Order is
+// part of it because post_process() results depend on it (first-come deduplication). Ranges are keyed exactly,
+// never quantized, as tracing points use the raw range. On a mismatch the keys become the reference for the
+// next frame, whose detections the caller then stores.
+bool UltrasoundProcessor::matches_previous_frame(const std::vector<SignalWay>& signal_ways) {
+    if (!config_.reuse_unchanged_frames) {
+        return false;
+    }
+    auto& keys = workspace_.frame_keys;
+    keys.clear();
+    for (const auto& sw : signal_ways) {
+        keys.push_back(pair_cache_model_key(sw.group_id, sw.signal_way_id, sw.distance_m, 0.0F));
+    }
+    if (has_previous_detections_ && keys == previous_frame_keys_) {
+        return true;
+    }
+    std::swap(keys, previous_frame_keys_);
+    has_previous_detections_ = false;
+    return false;
+}
+
+void UltrasoundProcessor::post_process(const std::vector<SignalWay>& signal_ways,
+                                       ProcessedDetections& out,
+                                       ProcessorWorkspace& ws,
+                                       PairIntersectionCache& pair_cache,
+                                       Diagnostics& diagnostics,
+                                       const PairPoolSource& pair_pool) const {
+    auto& ellipses = ws.ellipses;
+    auto& fov_models = ws.fov_models;
+    auto& ellipse_origins = ws.ellipse_origins;
+    auto& fov_origins = ws.fov_origins;
+    auto& ellipse_keys = ws.ellipse_keys;
+    auto& fov_keys = ws.fov_keys;
+    ellipses.clear();
+    ellipse_origins.clear();
+    ellipse_keys.clear();
+    fov_models.clear();
+    fov_origins.clear();
+    fov_keys.clear();
+    out.tracing.clear();
+    out.fov_intersections.clear();
+    out.ellipse_intersections.clear();
+    const bool cache_pairs = pair_cache.capacity() > 0U;
+    const float quantization_m = cache_pairs ? config_.pair_cache_quantization_m : 0.0F;
 
     for (const auto& sw : signal_ways) {
+        const SensorPairGeometry* pair = find_sensor_pair(plan_->pairs, sw.group_id, sw.signal_way_id);
         if (config_.processing_method == ProcessingMethod::SignalTracing ||
             config_.processing_method == ProcessingMethod::All) {
-            out.tracing.push_back(tracing_detection_from_signal_way(sw));
+            out.tracing.push_back(tracing_detection_from_signal_way(pair, sw));
+        }
+        if (pair == nullptr) {
+            continue;
         }
 
         if (config_.processing_method == ProcessingMethod::FovIntersection ||
             config_.processing_method == ProcessingMethod::All) {
-            if (const auto fov_pt = fov_pie_detection(sw); fov_pt.has_value()) {
+            if (const auto fov_pt = fov_pie_detection(*pair, sw); fov_pt.has_value()) {
                 out.fov_intersections.push_back(*fov_pt);
             }
-            if (const auto fov = build_fov_model_from_signal_way(sw); fov.has_value()) {
-                fov_models.push_back(*fov);
+            if (const auto fov = build_fov_model_from_signal_way(*pair, sw, quantization_m); fov.has_value()) {
+                fov_models.push_back(prepare_ellipse(*fov));
+                fov_origins.push_back(make_model_origin(sw.group_id, pair->tx, pair->rx));
+                fov_keys.push_back(pair_cache_model_key(sw.group_id, sw.signal_way_id, sw.distance_m, quantization_m) |
+                                   kFovModelKey);
             }
         }
 
         if (config_.processing_method == ProcessingMethod::EllipseIntersection ||
             config_.processing_method == ProcessingMethod::All) {
-            if (const auto ellipse = build_ellipse_from_signal_way(sw); ellipse.has_value()) {
-                ellipses.push_back(*ellipse);
+            if (const auto ellipse = build_ellipse_from_signal_way(*pair, sw, quantization_m); ellipse.has_value()) {
+                ellipses.push_back(prepare_ellipse(*ellipse));
+                ellipse_origins.push_back(make_model_origin(sw.group_id, pair->tx, pair->rx));
+                ellipse_keys.push_back(pair_cache_model_key(sw.group_id, sw.signal_way_id, sw.distance_m, quantization_m));
                 const auto seed = ellipse_point(*ellipse, 0.30 * std::numbers::pi_v<double>);
-                if (!is_inside_vehicle_contour(seed[0], seed[1])) {
+                if (!is_inside_vehicle_contour(*plan_, seed[0], seed[1])) {
                     out.ellipse_intersections.push_back(seed);
                 }
             }
         }
     }
 
+    PairPruningRules pair_rules;
+    pair_rules.skip_cross_group = config_.prune_cross_group_pairs;
+    pair_rules.max_sensor_gap = config_.max_pair_sensor_gap;
+    pair_rules.sensor_gaps = &plan_->sensor_gaps;
+    pair_rules.sensor_count = plan_->sensor_x_m.size();
+    PairParallelism parallel;
+    parallel.pool = &pair_pool;
+    parallel.min_pairs = config_.parallel_pair_threshold;
+
     if ((config_.processing_method == ProcessingMethod::EllipseIntersection ||
          config_.processing_method == ProcessingMethod::All) &&
         ellipses.size() > 1U) {
-        collect_ellipse_intersections_traverse(ellipses, out.ellipse_intersections);
-        collect_ellipse_intersections(ellipses, out.ellipse_intersections, 0.08, 0.2);
+        PairPruningRules rules = pair_rules;
+        if (config_.skip_confocal_pairs) {
+            diagnostics.skipped_ellipse_pairs += merge_duplicate_ellipses(ellipses, ellipse_origins, ellipse_keys);
+            rules.skip_same_sensor_pair = true;
+        }
+        PairGenerationStats stats;
+        generate_candidate_pairs(ellipses, ellipse_origins, rules, 0.2, ws.model_pairs, stats);
+        diagnostics.skipped_ellipse_pairs += stats.same_sensor_pair;
+        diagnostics.pruned_model_pairs += stats.pruned;
+        diagnostics.visited_model_pairs += stats.emitted;
+
+        PairReuse reuse;
+        if (cache_pairs) {
+            reuse.cache = &pair_cache;
+            reuse.keys = &ellipse_keys;
+        }
+        auto& unique = ws.unique_detections;
+        unique.attach(out.ellipse_intersections);
+        if (config_.intersection_solver == IntersectionSolver::Lookup && lut_ != nullptr) {
+            collect_ellipse_intersections_lookup(*plan_, *lut_, ellipses, ellipse_origins, ws.model_pairs,
+                                                 config_.lut_newton_polish, ws, unique, reuse, parallel, diagnostics);
+        } else {
+            collect_model_intersections(config_.intersection_solver, *plan_, ellipses, ws.model_pairs, ws, unique, 0.08,
+                                        0.2, true, reuse, parallel, diagnostics);
+        }
     }
 
     if ((config_.processing_method == ProcessingMethod::FovIntersection ||
          config_.processing_method == ProcessingMethod::All) &&
         fov_models.size() > 1U) {
-        collect_ellipse_intersections(fov_models, out.fov_intersections, 0.10, 0.25);
+        PairGenerationStats stats;
+        generate_candidate_pairs(fov_models, fov_origins, pair_rules, 0.25, ws.model_pairs, stats);
+        diagnostics.pruned_model_pairs += stats.pruned;
+        diagnostics.visited_model_pairs += stats.emitted;
+
+        PairReuse reuse;
+        if (cache_pairs) {
+            reuse.cache = &pair_cache;
+            reuse.keys = &fov_keys;
+        }
+        auto& unique = ws.unique_detections;
+        unique.attach(out.fov_intersections);
+        collect_model_intersections(config_.intersection_solver, *plan_, fov_models, ws.model_pairs, ws, unique, 0.10,
+                                    0.25, false, reuse, parallel, diagnostics);
     }
 
-    out.fused = fuse_method_detections(out);
-
-    out.clustered = cluster_with_table_melt(out.fused, static_cast<double>(config_.cluster_radius_m));
-
-    return out;
+    fuse_method_detections(out, ws, out.fused);
+    ws.clusterer.cluster(out.fused, static_cast<double>(config_.cluster_radius_m), out.clustered);
 }
 
 }  // namespace ultrasound
@@ -0,0 +1,251 @@
+#include "ultrasound/processor_fleet.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ultrasound {
+namespace {
+
+ProcessorConfig stream_config(ProcessorConfig config) {
+    config.parallel_pair_threshold = 0U;
+    return config;
+}
+
+std::uint64_t elapsed_us(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+double per_second(std::uint64_t frames, std::uint64_t us) {
+    return us > 0U ? static_cast<double>(frames) * 1.0e6 / static_cast<double>(us) : 0.0;
+}
+
+// A queued vehicle state or frame, applied to the processor in submission order.
+struct StreamItem {
+    bool is_frame{false};
+    VehicleState state{};
+    FrameInput frame{};
+};
+
+}  // namespace
+
+struct ProcessorFleet::Stream {
+    Stream(std::uint32_t id,
+           const ProcessorConfig& config,
+           std::shared_ptr<const GeometryPlan> plan,
+           std::shared_ptr<const IntersectionLut> lut)
+        : stream_id(id),
+          processor(config, std::move(plan), std::move(lut)) {}
+
+    const std::uint32_t stream_id;
+    // Touched only by the stream's task, of which at most one exists.
+    UltrasoundProcessor processor;
+    // Guards everything below.
+    std::mutex mutex{};
+    std::deque<StreamItem> pending{};
+    bool scheduled{false};
+    std::uint64_t last_state_us{0U};
+    bool has_state{false};
+    std::vector<FleetFrameResult> results{};
+    FleetStreamStats stats{};
+};
+
+ProcessorFleet::ProcessorFleet(ProcessorConfig config,
+                               std::shared_ptr<const GeometryPlan> plan,
+                               std::shared_ptr<const IntersectionLut> lut)
+    : config_(stream_config(std::move(config))),
+      plan_(plan != nullptr ? std::move(plan) : default_geometry_plan()),
+      lut_(std::move(lut)),
+      pool_(config_.worker_threads) {
+    // The first processor builds (or validates) the LOOKUP table; every stream then shares that one.
+    if (config_.intersection_solver == IntersectionSolver::Lookup) {
+        lut_ = UltrasoundProcessor(config_, plan_, lut_).intersection_lut();
+    } else {
+        lut_.reset();
+    }
+}
+
+ProcessorFleet::~ProcessorFleet() {
+    pool_.wait_idle();
+}
+
+Status ProcessorFleet::add_stream(std::uint32_t stream_id) {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    if (streams_.count(stream_id) != 0U) {
+        return Status::fail(ErrorCode::InvalidInput, "stream already exists");
+    }
+    auto stream = std::make_unique<Stream>(stream_id, config_, plan_, lut_);
+    stream->stats.stream_id = stream_id;
+    streams_.emplace(stream_id, std::move(stream));
+    return Status::ok();
+}
+
+ProcessorFleet::Stream* ProcessorFleet::find_stream(std::uint32_t stream_id) const {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    const auto it = streams_.find(stream_id);
+    return it != streams_.end() ? it->second.get() : nullptr;
+}
+
+Status ProcessorFleet::push_vehicle_state(std::uint32_t stream_id, const VehicleState& state) {
+    Stream* stream = find_stream(stream_id);
+    if (stream == nullptr) {
+        return Status::fail(ErrorCode::InvalidInput, "unknown stream");
+    }
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        // Checked here, as the processor will only see the state once the stream's earlier work is done.
+        if (stream->has_state && state.timestamp_us <= stream->last_state_us) {
+            return Status::fail(ErrorCode::InvalidInput, "vehicle state timestamps must be monotonic");
+        }
+        stream->has_state = true;
+        stream->last_state_us = state.timestamp_us;
+        StreamItem item;
+        item.state = state;
+        stream->pending.push_back(std::move(item));
+    }
+    schedule(*stream);
+    return Status::ok();
+}
+
+Status ProcessorFleet::submit_frame(std::uint32_t stream_id, FrameInput frame) {
+    Stream* stream = find_stream(stream_id);
+    if (stream == nullptr) {
+        return Status::fail(ErrorCode::InvalidInput, "unknown stream");
+    }
+    {
+        std::lock_guard<std::mutex> lock(timing_mutex_);
+        if (!first_submit_.has_value()) {
+            first_submit_ = std::chrono::steady_clock::now();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        StreamItem item;
+        item.is_frame = true;
+        item.frame = std::move(frame);
+        stream->pending.push_back(std::move(item));
+    }
+    schedule(*stream);
+    return Status::ok();
+}
+
+void ProcessorFleet::schedule(Stream& stream) {
+    {
+        std::lock_guard<std::mutex> lock(stream.mutex);
+        if (stream.scheduled || stream.pending.empty()) {
+            return;
+        }
+        stream.scheduled = true;
+    }
+    pool_.submit([this, &stream] { run_stream(stream); });
+}
+
+// Applies queued vehicle states up to and including the next frame, then hands the stream back to the pool if
+// more work is queued. Resubmitted from a pool thread, the task lands on that thread's deque, where the stream
+// stays warm unless an idle thread steals it.
+void ProcessorFleet::run_stream(Stream& stream) {
+    while (true) {
+        StreamItem item;
+        {
+            std::lock_guard<std::mutex> lock(stream.mutex);
+            if (stream.pending.empty()) {
+                stream.scheduled = false;
+                return;
+            }
+            item = std::move(stream.pending.front());
+            stream.pending.pop_front();
+        }
+        if (!item.is_frame) {
+            // Already validated against the stream's earlier states.
+            (void)stream.processor.push_vehicle_state(item.state);
+            continue;
+        }
+
+        FleetFrameResult result;
+        result.timestamp_us = item.frame.timestamp_us;
+        const auto start = std::chrono::steady_clock::now();
+        result.status = stream.processor.process_frame(std::move(item.frame), result.output);
+        const auto end = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(timing_mutex_);
+            last_finish_ = std::max(last_finish_, end);
+        }
+        bool more = false;
+        {
+            std::lock_guard<std::mutex> lock(stream.mutex);
+            ++(result.status.is_ok() ? stream.stats.processed_frames : stream.stats.failed_frames);
+            stream.stats.busy_us += elapsed_us(start, end);
+            stream.results.push_back(std::move(result));
+            more = !stream.pending.empty();
+            stream.scheduled = more;
+        }
+        if (more) {
+            pool_.submit([this, &stream] { run_stream(stream); });
+        }
+        return;
+    }
+}
+
+void ProcessorFleet::wait_idle() {
+    pool_.wait_idle();
+}
+
+Status ProcessorFleet::take_results(std::uint32_t stream_id, std::vector<FleetFrameResult>& results) {
+    Stream* stream = find_stream(stream_id);
+    if (stream == nullptr) {
+        return Status::fail(ErrorCode::InvalidInput, "unknown stream");
+    }
+    results.clear();
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    std::swap(results, stream->results);
+    return Status::ok();
+}
+
+FleetStats ProcessorFleet::stats() const {
+    FleetStats out;
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        out.streams.reserve(streams_.size());
+        for (const auto& entry : streams_) {
+            std::lock_guard<std::mutex> stream_lock(entry.second->mutex);
+            out.streams.push_back(entry.second->stats);
+        }
+    }
+    std::sort(out.streams.begin(), out.streams.end(),
+              [](const FleetStreamStats& a, const FleetStreamStats& b) { return a.stream_id < b.stream_id; });
+    for (auto& s : out.streams) {
+        s.frames_per_second = per_second(s.processed_frames + s.failed_frames, s.busy_us);
+        out.processed_frames += s.processed_frames;
+        out.failed_frames += s.failed_frames;
+        out.busy_us += s.busy_us;
+    }
+    {
+        std::lock_guard<std::mutex> lock(timing_mutex_);
+        if (first_submit_.has_value() && last_finish_ > *first_submit_) {
+            out.wall_us = elapsed_us(*first_submit_, last_finish_);
+        }
+    }
+    out.steals = pool_.steals();
+    out.frames_per_second = per_second(out.processed_frames + out.failed_frames, out.wall_us);
+    return out;
+}
+
+const std::shared_ptr<const GeometryPlan>& ProcessorFleet::geometry_plan() const {
+    return plan_;
+}
+
+const std::shared_ptr<const IntersectionLut>& ProcessorFleet::intersection_lut() const {
+    return lut_;
+}
+
+const UltrasoundProcessor* ProcessorFleet::processor(std::uint32_t stream_id) const {
+    const Stream* stream = find_stream(stream_id);
+    return stream != nullptr ? &stream->processor : nullptr;
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,203 @@
+#include "ultrasound/processor_pipeline.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace ultrasound {
+namespace {
+
+std::uint64_t elapsed_us(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+}  // namespace
+
+// Enough slots to fill every stage ring and still have one per stage in hand; the free ring holds them all, so
+// the publish stage never waits on it.
+ProcessorPipeline::ProcessorPipeline(UltrasoundProcessor& processor,
+                                     PipelineFrameCallback on_frame,
+                                     std::size_t queue_capacity)
+    : processor_(processor),
+      on_frame_(std::move(on_frame)),
+      slots_(3U * std::bit_ceil(std::max<std::size_t>(queue_capacity, 2U)) + 3U),
+      free_(slots_.size()),
+      to_admit_(queue_capacity),
+      to_postprocess_(queue_capacity),
+      to_publish_(queue_capacity) {
+    for (auto& slot : slots_) {
+        (void)free_.try_push(&slot);
+    }
+    admit_thread_ = std::thread([this] { run_admit(); });
+    postprocess_thread_ = std::thread([this] { run_postprocess(); });
+    publish_thread_ = std::thread([this] { run_publish(); });
+}
+
+ProcessorPipeline::~ProcessorPipeline() {
+    stop();
+}
+
+ProcessorPipeline::Item* ProcessorPipeline::acquire_slot() {
+    Item* slot = nullptr;
+    while (!free_.try_pop(slot)) {
+        submit_stalls_.fetch_add(1U, std::memory_order_relaxed);
+        free_.wait_for_item();
+    }
+    return slot;
+}
+
+void ProcessorPipeline::enqueue(Item* item) {
+    while (!to_admit_.try_push(item)) {
+        submit_stalls_.fetch_add(1U, std::memory_order_relaxed);
+        to_admit_.wait_for_space();
+    }
+}
+
+Status ProcessorPipeline::push_vehicle_state(const VehicleState& state) {
+    // Checked here, as the processor only sees the state once the admit stage reaches it.
+    if (has_state_ && state.timestamp_us <= last_state_us_) {
+        return Status::fail(ErrorCode::InvalidInput, "vehicle state timestamps must be monotonic");
+    }
+    has_state_ = true;
+    last_state_us_ = state.timestamp_us;
+    Item* item = acquire_slot();
+    item->is_frame = false;
+    item->state = state;
+    enqueue(item);
+    return Status::ok();
+}
+
+std::uint64_t ProcessorPipeline::submit(FrameInput frame) {
+    Item* item = acquire_slot();
+    item->is_frame = true;
+    item->sequence = submitted_.load(std::memory_order_relaxed);
+    item->input = std::move(frame);
+    const std::uint64_t sequence = item->sequence;
+    enqueue(item);
+    submitted_.store(sequence + 1U, std::memory_order_relaxed);
+    return sequence;
+}
+
+void ProcessorPipeline::flush() {
+    const std::uint64_t submitted = submitted_.load(std::memory_order_relaxed);
+    for (std::uint64_t published = published_.load(std::memory_order_acquire); published < submitted;
+         published = published_.load(std::memory_order_acquire)) {
+        published_.wait(published, std::memory_order_acquire);
+    }
+}
+
+void ProcessorPipeline::stop() {
+    if (stopped_) {
+        return;
+    }
+    flush();
+    enqueue(nullptr);
+    admit_thread_.join();
+    postprocess_thread_.join();
+    publish_thread_.join();
+    stopped_ = true;
+    processor_.absorb_stage_diagnostics(postprocess_diagnostics_);
+    processor_.absorb_stage_diagnostics(publish_diagnostics_);
+}
+
+ProcessorPipeline::Item* ProcessorPipeline::next_item(SpscRing<Item*>& in, StageCounters& counters) {
+    in.wait_for_item();
+    const std::size_t depth = in.size();
+    if (depth > counters.max_queue_depth.load(std::memory_order_relaxed)) {
+        counters.max_queue_depth.store(depth, std::memory_order_relaxed);
+    }
+    Item* item = nullptr;
+    (void)in.try_pop(item);
+    return item;
+}
+
+void ProcessorPipeline::forward(Item* item, SpscRing<Item*>& out, StageCounters& counters) {
+    while (!out.try_push(item)) {
+        counters.stalls.fetch_add(1U, std::memory_order_relaxed);
+        out.wait_for_space();
+    }
+}
+
+void ProcessorPipeline::run_admit() {
+    while (Item* item = next_item(to_admit_, admit_counters_)) {
+        if (!item->is_frame) {
+            // Checked against the pipeline's earlier states already, but the processor may also have taken in
+            // states offered through its channel.
+            if (!processor_.push_vehicle_state(item->state).is_ok()) {
+                ++processor_.diagnostics_.rejected_vehicle_states;
+            }
+        } else {
+            item->timing = StageTimingUs{};
+            Pose2d pose;
+            item->status = processor_.admit_frame(item->input, pose, item->timing);
+            if (item->status.is_ok()) {
+                const auto t_convert_start = std::chrono::steady_clock::now();
+                processor_.convert_frame(item->input, &item->input, pose, item->output);
+                item->timing.convert = elapsed_us(t_convert_start, std::chrono::steady_clock::now());
+                // The post-process stage handles frames in this order, so a frame that is not reused will have
+                // set the previous detections before any later frame reuses them.
+                item->reuse = processor_.matches_previous_frame(item->output.signal_ways);
+                if (!item->reuse) {
+                    processor_.has_previous_detections_ = processor_.config_.reuse_unchanged_frames;
+                }
+            }
+        }
+        forward(item, to_postprocess_, admit_counters_);
+        admit_counters_.items.fetch_add(1U, std::memory_order_relaxed);
+    }
+    forward(nullptr, to_postprocess_, admit_counters_);
+}
+
+void ProcessorPipeline::run_postprocess() {
+    while (Item* item = next_item(to_postprocess_, postprocess_counters_)) {
+        if (item->is_frame && item->status.is_ok()) {
+            const auto t_postprocess_start = std::chrono::steady_clock::now();
+            processor_.post_process_frame(item->output, item->reuse, postprocess_diagnostics_);
+            item->timing.postprocess = elapsed_us(t_postprocess_start, std::chrono::steady_clock::now());
+        }
+        forward(item, to_publish_, postprocess_counters_);
+        postprocess_counters_.items.fetch_add(1U, std::memory_order_relaxed);
+    }
+    forward(nullptr, to_publish_, postprocess_counters_);
+}
+
+void ProcessorPipeline::run_publish() {
+    while (Item* item = next_item(to_publish_, publish_counters_)) {
+        if (item->is_frame) {
+            if (item->status.is_ok()) {
+                UltrasoundProcessor::publish_frame(item->output, item->timing, publish_diagnostics_);
+            }
+            if (on_frame_) {
+                on_frame_(item->sequence, item->status, item->output);
+            }
+            published_.fetch_add(1U, std::memory_order_release);
+            published_.notify_all();
+        }
+        forward(item, free_, publish_counters_);
+        publish_counters_.items.fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+PipelineStats ProcessorPipeline::stats() const {
+    const auto stage = [](const StageCounters& counters, const SpscRing<Item*>& in) {
+        PipelineStageStats s;
+        s.items = counters.items.load(std::memory_order_relaxed);
+        s.stalls = counters.stalls.load(std::memory_order_relaxed);
+        s.queue_depth = in.size();
+        s.max_queue_depth = counters.max_queue_depth.load(std::memory_order_relaxed);
+        return s;
+    };
+    PipelineStats out;
+    out.submitted_frames = submitted_.load(std::memory_order_relaxed);
+    out.published_frames = published_.load(std::memory_order_acquire);
+    out.submit_stalls = submit_stalls_.load(std::memory_order_relaxed);
+    out.admit = stage(admit_counters_, to_admit_);
+    out.postprocess = stage(postprocess_counters_, to_postprocess_);
+    out.publish = stage(publish_counters_, to_publish_);
+    return out;
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,157 @@
+#include "ultrasound/spatial_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ultrasound {
+namespace {
+
+constexpr std::size_t kInitialSlots = 64U;
+// Cells are made marginally wider than the query radius so that rounding in x / cell can never push a
+// neighbour within the radius two cells away.
+constexpr double kCellMargin = 1.0 + 1.0e-9;
+constexpr double kMaxCellCoord = 1.0e12;
+
+// splitmix64 finalizer: both packed cell coordinates reach the low bits used by the mask.
+std::size_t hash_cell(std::int64_t key, std::size_t mask) {
+    std::uint64_t h = static_cast<std::uint64_t>(key);
+    h = (h ^ (h >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27U)) * 0x94D049BB133111EBULL;
+    h ^= h >> 31U;
+    return static_cast<std::size_t>(h) & mask;
+}
+
+}  // namespace
+
+SpatialHashGrid::SpatialHashGrid(double cell_size_m)
+    : inv_cell_(1.0 / (cell_size_m * kCellMargin)),
+      slots_(kInitialSlots) {}
+
+void SpatialHashGrid::clear(std::size_t expected_points) {
+    next_.clear();
+    next_.reserve(expected_points);
+    used_slots_ = 0U;
+    std::size_t capacity = slots_.size();
+    while (capacity < 2U * expected_points) {
+        capacity *= 2U;
+    }
+    slots_.assign(capacity, Slot{});
+}
+
+void SpatialHashGrid::insert(const std::array<double, 2U>& p, std::int32_t index) {
+    if (2U * (used_slots_ + 1U) > slots_.size()) {
+        rehash(slots_.size() * 2U);
+    }
+    const std::int64_t key = pack_cell(cell_of(p[0]), cell_of(p[1]));
+    auto& slot = slots_[find_slot(key)];
+    if (slot.head < 0) {
+        slot.key = key;
+        ++used_slots_;
+    }
+    // Chains are only walked, never ordered, so prepending keeps insertion O(1).
+    next_.push_back(slot.head);
+    slot.head = index;
+}
+
+std::int64_t SpatialHashGrid::pack_cell(std::int64_t ix, std::int64_t iy) {
+    return static_cast<std::int64_t>((static_cast<std::uint64_t>(ix) << 32U) ^
+                                     (static_cast<std::uint64_t>(iy) & 0xFFFFFFFFULL));
+}
+
+std::int64_t SpatialHashGrid::cell_of(double v) const {
+    return static_cast<std::int64_t>(std::floor(std::clamp(v * inv_cell_, -kMaxCellCoord, kMaxCellCoord)));
+}
+
+std::size_t SpatialHashGrid::find_slot(std::int64_t key) const {
+    const std::size_t mask = slots_.size() - 1U;
+    std::size_t i = hash_cell(key, mask);
+    while (slots_[i].head >= 0 && slots_[i].key != key) {
+        i = (i + 1U) & mask;
+    }
+    return i;
+}
+
+void SpatialHashGrid::rehash(std::size_t capacity) {
+    std::vector<Slot> old;
+    old.swap(slots_);
+    slots_.assign(capacity, Slot{});
+    for (const auto& slot : old) {
+        if (slot.head >= 0) {
+            slots_[find_slot(slot.key)] = slot;
+        }
+    }
+}
+
+UniqueDetectionGrid::UniqueDetectionGrid(double min_separation_m)
+    : min_sep_sq_(min_separation_m * min_separation_m),
+      grid_(min_separation_m) {}
+
+void UniqueDetectionGrid::attach(std::vector<std::array<double, 2U>>& detections) {
+    detections_ = &detections;
+    grid_.clear(detections.size());
+    for (std::size_t i = 0; i < detections.size(); ++i) {
+        grid_.insert(detections[i], static_cast<std::int32_t>(i));
+    }
+}
+
+bool UniqueDetectionGrid::push(const std::array<double, 2U>& candidate) {
+    auto& detections = *detections_;
+    const bool duplicate = grid_.visit_neighbourhood(candidate, [&](std::int32_t k) {
+        const auto& p = detections[static_cast<std::size_t>(k)];
+        const double dx = p[0] - candidate[0];
+        const double dy = p[1] - candidate[1];
+        return (dx * dx + dy * dy) <= min_sep_sq_;
+    });
+    if (duplicate) {
+        return false;
+    }
+    detections.push_back(candidate);
+    grid_.insert(candidate, static_cast<std::int32_t>(detections.size() - 1U));
+    return true;
+}
+
+MethodSupportGrid::MethodSupportGrid(double radius_m)
+    : radius_sq_(radius_m * radius_m),
+      grid_(radius_m) {}
+
+void MethodSupportGrid::clear(std::size_t expected_points) {
+    grid_.clear(expected_points);
+    points_.clear();
+    methods_.clear();
+    points_.reserve(expected_points);
+    methods_.reserve(expected_points);
+}
+
+void MethodSupportGrid::insert(const std::array<double, 2U>& p, std::uint8_t method_bit) {
+    grid_.insert(p, static_cast<std::int32_t>(points_.size()));
+    points_.push_back(p);
+    methods_.push_back(method_bit);
+}
+
+void MethodSupportGrid::insert_all(const std::vector<std::array<double, 2U>>& points, std::uint8_t method_bit) {
+    for (const auto& p : points) {
+        insert(p, method_bit);
+    }
+}
+
+std::uint8_t MethodSupportGrid::support_mask(const std::array<double, 2U>& candidate, std::uint8_t all_methods) const {
+    std::uint8_t mask = 0U;
+    grid_.visit_neighbourhood(candidate, [&](std::int32_t k) {
+        const auto i = static_cast<std::size_t>(k);
+        if ((mask & methods_[i]) != 0U) {
+            return false;
+        }
+        const double dx = points_[i][0] - candidate[0];
+        const double dy = points_[i][1] - candidate[1];
+        if ((dx * dx + dy * dy) <= radius_sq_) {
+            mask = static_cast<std::uint8_t>(mask | methods_[i]);
+        }
+        return (mask & all_methods) == all_methods;
+    });
+    return mask;
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,89 @@
+#include "ultrasound/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ultrasound {
+
+ThreadPool::ThreadPool(std::size_t background_threads) {
+    threads_.reserve(background_threads);
+    for (std::size_t i = 0; i < background_threads; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i + 1U); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::drain(std::size_t slot) {
+    for (std::size_t i = next_.fetch_add(1U, std::memory_order_relaxed); i < count_;
+         i = next_.fetch_add(1U, std::memory_order_relaxed)) {
+        (*body_)(i, slot);
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body) {
+    if (count == 0U) {
+        return;
+    }
+    std::lock_guard<std::mutex> loop_lock(loop_mutex_);
+    if (threads_.empty() || count == 1U) {
+        for (std::size_t i = 0; i < count; ++i) {
+            body(i, 0U);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        count_ = count;
+        next_.store(0U, std::memory_order_relaxed);
+        busy_workers_ = threads_.size();
+        ++generation_;
+    }
+    start_cv_.notify_all();
+    drain(0U);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return busy_workers_ == 0U; });
+    body_ = nullptr;
+}
+
+void ThreadPool::worker_loop(std::size_t slot) {
+    std::uint64_t seen = 0U;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+        drain(slot);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --busy_workers_;
+        }
+        done_cv_.notify_one();
+    }
+}
+
+std::size_t background_threads_for(std::size_t threads) {
+    if (threads == 0U) {
+        threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+    }
+    return threads - 1U;
+}
+
+}  // namespace ultrasound
@@ -0,0 +1,121 @@
+#include "ultrasound/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace ultrasound {
+namespace {
+
+// Pool and deque index of the calling thread, when it is a pool thread.
+struct CurrentWorker {
+    const WorkStealingPool* pool{nullptr};
+    std::size_t slot{0U};
+};
+
+thread_local CurrentWorker current_worker;
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t threads) {
+    if (threads == 0U) {
+        threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait_idle();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    const std::size_t slot = current_worker.pool == this
+                                 ? current_worker.slot
+                                 : next_worker_.fetch_add(1U, std::memory_order_relaxed) % workers_.size();
+    // Counted before it is visible, so a thief can never see more tasks than queued_ admits.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_;
+        ++unfinished_;
+    }
+    {
+        auto& worker = *workers_[slot];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    work_cv_.notify_one();
+}
+
+void WorkStealingPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return unfinished_ == 0U; });
+}
+
+bool WorkStealingPool::take_task(std::size_t slot, Task& task) {
+    bool found = false;
+    {
+        auto& own = *workers_[slot];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (std::size_t k = 1; !found && k < workers_.size(); ++k) {
+        auto& victim = *workers_[(slot + k) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            steals_.fetch_add(1U, std::memory_order_relaxed);
+            found = true;
+        }
+    }
+    if (found) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --queued_;
+    }
+    return found;
+}
+
+void WorkStealingPool::worker_loop(std::size_t slot) {
+    current_worker = {this, slot};
+    Task task;
+    while (true) {
+        if (take_task(slot, task)) {
+            task();
+            task = nullptr;
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--unfinished_ == 0U) {
+                idle_cv_.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_cv_.wait(lock, [this] { return stop_ || queued_ > 0U; });
+        if (stop_ && queued_ == 0U) {
+            return;
+        }
+    }
+}
+
+}  // namespace ultrasound
@@ -112,12 +112,92 @@ Status load_processor_config_from_ini(const std::string& ini_path, ProcessorConf
                 } else {
                     return Status::fail(ErrorCode::InvalidInput, "invalid SignalWays.method");
                 }
+            } else if (section == "SignalWays" && key == "intersectionSolver") {
+                if (value == "SAMPLED" || value == "0") {
+                    config.intersection_solver = IntersectionSolver::Sampled;
+                } else if (value == "ANALYTIC" || value == "1") {
+                    config.intersection_solver = IntersectionSolver::Analytic;
+                } else if (value == "ADAPTIVE" || value == "2") {
+                    config.intersection_solver = IntersectionSolver::Adaptive;
+                } else if (value == "LOOKUP" || value == "3") {
+                    config.intersection_solver = IntersectionSolver::Lookup;
+                } else {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid SignalWays.intersectionSolver");
+                }
+            } else if (section == "SignalWays" && key == "skipConfocalPairs") {
+                bool parsed = false;
+                if (!parse_bool(value, parsed)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid bool for SignalWays.skipConfocalPairs");
+                }
+                config.skip_confocal_pairs = parsed;
+            } else if (section == "SignalWays" && key == "pruneCrossGroupPairs") {
+                bool parsed = false;
+                if (!parse_bool(value, parsed)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid bool for SignalWays.pruneCrossGroupPairs");
+                }
+                config.prune_cross_group_pairs = parsed;
+            } else if (section == "SignalWays" && key == "maxPairSensorGap") {
+                const int gap = std::stoi(value);
+                if (gap < 0 || gap > 255) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid SignalWays.maxPairSensorGap");
+                }
+                config.max_pair_sensor_gap = static_cast<std::uint8_t>(gap);
+            } else if (section == "SignalWays" && key == "lutResolution") {
+                const int resolution = std::stoi(value);
+                if (resolution < 2 || resolution > 1024) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid SignalWays.lutResolution");
+                }
+                config.lut_resolution = static_cast<std::uint16_t>(resolution);
+            } else if (section == "SignalWays" && key == "lutNewtonPolish") {
+                bool parsed = false;
+                if (!parse_bool(value, parsed)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid bool for SignalWays.lutNewtonPolish");
+                }
+                config.lut_newton_polish = parsed;
+            } else if (section == "SignalWays" && key == "lutCachePath") {
+                config.lut_cache_path = value;
+            } else if (section == "SignalWays" && key == "pairCacheCapacity") {
+                const long capacity = std::stol(value);
+                if (capacity < 0 || capacity > (1L << 20)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid SignalWays.pairCacheCapacity");
+                }
+                config.pair_cache_capacity = static_cast<std::uint32_t>(capacity);
+            } else if (section == "SignalWays" && key == "pairCacheQuantizationM") {
+                const float step = std::stof(value);
+                if (!(step >= 0.0F)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid SignalWays.pairCacheQuantizationM");
+                }
+                config.pair_cache_quantization_m = step;
+            } else if (section == "SignalWays" && key == "reuseUnchangedFrames") {
+                bool parsed = false;
+                if (!parse_bool(value, parsed)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid bool for SignalWays.reuseUnchangedFrames");
+                }
+                config.reuse_unchanged_frames = parsed;
             } else if (section == "SignalWays" && key == "clusterRadiusM") {
                 config.cluster_radius_m = std::stof(value);
             } else if (section == "General" && key == "minRangeM") {
                 config.min_range_m = std::stof(value);
             } else if (section == "General" && key == "maxRangeM") {
                 config.max_range_m = std::stof(value);
+            } else if (section == "General" && key == "workerThreads") {
+                const int threads = std::stoi(value);
+                if (threads < 0 || threads > 1024) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid General.workerThreads");
+                }
+                config.worker_threads = static_cast<std::uint16_t>(threads);
+            } else if (section == "General" && key == "parallelPairThreshold") {
+                const long threshold = std::stol(value);
+                if (threshold < 0 || threshold > (1L << 20)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid General.parallelPairThreshold");
+                }
+                config.parallel_pair_threshold = static_cast<std::uint32_t>(threshold);
+            } else if (section == "General" && key == "vehicleStateChannelCapacity") {
+                const long capacity = std::stol(value);
+                if (capacity < 1 || capacity > static_cast<long>(kMaxVehicleStates)) {
+                    return Status::fail(ErrorCode::InvalidInput, "invalid General.vehicleStateChannelCapacity");
+                }
+                config.vehicle_state_channel_capacity = static_cast<std::uint32_t>(capacity);
             } else if (section == "General" && key == "strictMonotonicTimestamps") {
                 bool parsed = false;
                 if (!parse_bool(value, parsed)) {
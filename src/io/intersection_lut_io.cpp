@@ -0,0 +1,153 @@
+#include "ultrasound/intersection_lut_io.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ultrasound {
+namespace {
+
+constexpr std::array<char, 8U> kMagic{'U', 'S', 'S', 'L', 'U', 'T', '0', '1'};
+
+template <typename T>
+void write_value(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void write_vector(std::ofstream& out, const std::vector<T>& values) {
+    write_value(out, static_cast<std::uint64_t>(values.size()));
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+bool read_value(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <typename T>
+bool read_vector(std::ifstream& in, std::vector<T>& values, std::uint64_t max_size) {
+    std::uint64_t size = 0U;
+    if (!read_value(in, size) || size > max_size) {
+        return false;
+    }
+    values.resize(static_cast<std::size_t>(size));
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(size * sizeof(T))));
+}
+
+// Bound on the header's grid and index sizes, so the products below cannot wrap.
+constexpr std::size_t kMaxDimension = std::size_t{1} << 16U;
+
+bool consistent(const IntersectionLut& lut) {
+    if (lut.resolution > kMaxDimension || lut.sensor_count > kMaxDimension || lut.foci_count > kMaxDimension) {
+        return false;
+    }
+    const std::size_t nodes = lut.resolution * lut.resolution;
+    if (lut.resolution < 2U || !(lut.step_m > 0.0) || lut.foci_index.size() != lut.sensor_count * lut.sensor_count ||
+        lut.table_index.size() != lut.foci_count * lut.foci_count || lut.counts.size() % nodes != 0U ||
+        lut.points.size() != lut.counts.size() * IntersectionLut::kMaxPoints) {
+        return false;
+    }
+    const auto tables = static_cast<std::int64_t>(lut.counts.size() / nodes);
+    for (const auto index : lut.foci_index) {
+        if (index >= static_cast<std::int64_t>(lut.foci_count)) {
+            return false;
+        }
+    }
+    for (const auto index : lut.table_index) {
+        if (index >= tables) {
+            return false;
+        }
+    }
+    for (const auto count : lut.counts) {
+        if (count > IntersectionLut::kMaxPoints && count != IntersectionLut::kUndefined) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+Status save_intersection_lut(const IntersectionLut& lut, const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return Status::fail(ErrorCode::InvalidInput, "unable to write intersection table: " + path);
+    }
+    out.write(kMagic.data(), static_cast<std::streamsize>(kMagic.size()));
+    write_value(out, lut.geometry_fingerprint);
+    write_value(out, static_cast<std::uint64_t>(lut.resolution));
+    write_value(out, lut.min_range_m);
+    write_value(out, lut.max_range_m);
+    write_value(out, lut.step_m);
+    write_value(out, static_cast<std::uint64_t>(lut.sensor_count));
+    write_value(out, static_cast<std::uint64_t>(lut.foci_count));
+    write_vector(out, lut.foci_index);
+    write_vector(out, lut.table_index);
+    write_vector(out, lut.counts);
+    write_vector(out, lut.points);
+    if (!out) {
+        return Status::fail(ErrorCode::InternalError, "failed writing intersection table: " + path);
+    }
+    return Status::ok();
+}
+
+Status load_intersection_lut(const std::string& path, std::shared_ptr<const IntersectionLut>& lut) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return Status::fail(ErrorCode::InvalidInput, "unable to open intersection table: " + path);
+    }
+    std::array<char, 8U> magic{};
+    auto loaded = std::make_shared<IntersectionLut>();
+    std::uint64_t resolution = 0U;
+    std::uint64_t sensor_count = 0U;
+    std::uint64_t foci_count = 0U;
+    // Generous bounds so a corrupt size field fails the read instead of exhausting memory.
+    constexpr std::uint64_t kMaxEntries = 1ULL << 32U;
+    const bool ok = in.read(magic.data(), static_cast<std::streamsize>(magic.size())) && magic == kMagic &&
+                    read_value(in, loaded->geometry_fingerprint) && read_value(in, resolution) &&
+                    read_value(in, loaded->min_range_m) && read_value(in, loaded->max_range_m) &&
+                    read_value(in, loaded->step_m) && read_value(in, sensor_count) && read_value(in, foci_count) &&
+                    read_vector(in, loaded->foci_index, kMaxEntries) && read_vector(in, loaded->table_index, kMaxEntries) &&
+                    read_vector(in, loaded->counts, kMaxEntries) && read_vector(in, loaded->points, kMaxEntries);
+    if (!ok) {
+        return Status::fail(ErrorCode::InvalidInput, "malformed intersection table: " + path);
+    }
+    if (resolution > kMaxDimension || sensor_count > kMaxDimension || foci_count > kMaxDimension) {
+        return Status::fail(ErrorCode::InvalidInput, "inconsistent intersection table: " + path);
+    }
+    loaded->resolution = static_cast<std::size_t>(resolution);
+    loaded->sensor_count = static_cast<std::size_t>(sensor_count);
+    loaded->foci_count = static_cast<std::size_t>(foci_count);
+    if (!consistent(*loaded)) {
+        return Status::fail(ErrorCode::InvalidInput, "inconsistent intersection table: " + path);
+    }
+    lut = std::move(loaded);
+    return Status::ok();
+}
+
+Status load_or_build_intersection_lut(const GeometryPlan& plan,
+                                      const ProcessorConfig& config,
+                                      std::shared_ptr<const IntersectionLut>& lut) {
+    const double min_range = static_cast<double>(config.min_range_m);
+    const double max_range = static_cast<double>(config.max_range_m);
+    if (!config.lut_cache_path.empty()) {
+        std::shared_ptr<const IntersectionLut> cached;
+        if (load_intersection_lut(config.lut_cache_path, cached).is_ok() &&
+            intersection_lut_matches(*cached, plan, min_range, max_range, config.lut_resolution)) {
+            lut = std::move(cached);
+            return Status::ok();
+        }
+    }
+    lut = build_intersection_lut(plan, min_range, max_range, config.lut_resolution);
+    if (config.lut_cache_path.empty()) {
+        return Status::ok();
+    }
+    return save_intersection_lut(*lut, config.lut_cache_path);
+}
+
+}  // namespace ultrasound
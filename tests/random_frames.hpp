@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "ultrasound/types.hpp"
+
+namespace ultrasound::test {
+
+// Random replay frames for tests comparing processing paths: signal ways with ranges in [0.2, 5.6] m over
+// groups 0-2 and ids 0-16 (some of which the filter or the sensor-pair table drops), plus optional repeated
+// and late frames.
+struct RandomFrameSpec {
+    std::uint32_t seed{1U};
+    std::size_t frames{0U};
+    std::uint64_t start_us{1100U};
+    std::uint64_t step_us{10U};
+    int min_signal_ways{0};
+    int max_signal_ways{16};
+    // Frame f repeats the previous frame's signal ways when f % repeat_every == repeat_phase (0 disables).
+    std::uint64_t repeat_every{0U};
+    std::uint64_t repeat_phase{0U};
+    // Frame f is stamped late_by_us early, i.e. out of order, when f % late_every == late_phase (0 disables).
+    std::uint64_t late_every{0U};
+    std::uint64_t late_phase{0U};
+    std::uint64_t late_by_us{0U};
+};
+
+inline std::vector<FrameInput> random_frames(const RandomFrameSpec& spec) {
+    std::mt19937 rng(spec.seed);
+    std::uniform_real_distribution<float> range(0.2F, 5.6F);
+    std::uniform_int_distribution<int> count(spec.min_signal_ways, spec.max_signal_ways);
+    std::uniform_int_distribution<int> way(0, 16);
+    std::uniform_int_distribution<int> group(0, 2);
+    std::vector<FrameInput> frames;
+    frames.reserve(spec.frames);
+    for (std::uint64_t f = 0; f < spec.frames; ++f) {
+        FrameInput in;
+        in.timestamp_us = spec.start_us + spec.step_us * f;
+        if (spec.late_every > 0U && f % spec.late_every == spec.late_phase) {
+            in.timestamp_us -= spec.late_by_us;
+        }
+        if (spec.repeat_every > 0U && f % spec.repeat_every == spec.repeat_phase && !frames.empty()) {
+            in.signal_ways = frames.back().signal_ways;
+        } else {
+            const int n = spec.min_signal_ways == spec.max_signal_ways ? spec.min_signal_ways : count(rng);
+            for (int k = 0; k < n; ++k) {
+                in.signal_ways.push_back({in.timestamp_us, range(rng), static_cast<std::uint8_t>(group(rng)),
+                                          static_cast<std::uint8_t>(way(rng))});
+            }
+        }
+        frames.push_back(std::move(in));
+    }
+    return frames;
+}
+
+}  // namespace ultrasound::test
@@ -0,0 +1,88 @@
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/clustering.hpp"
+
+namespace {
+
+using Point = std::array<double, 2U>;
+
+// Dense flood-fill formulation the clusterer replaces.
+std::vector<Point> cluster_dense(const std::vector<Point>& in, double radius_m) {
+    const std::size_t n = in.size();
+    std::vector<int> id(n, 0);
+    int next_id = 0;
+    for (std::size_t seed = 0; seed < n; ++seed) {
+        if (id[seed] != 0) {
+            continue;
+        }
+        id[seed] = ++next_id;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (std::size_t a = 0; a < n; ++a) {
+                for (std::size_t b = 0; id[a] == next_id && b < n; ++b) {
+                    const double dx = in[b][0] - in[a][0];
+                    const double dy = in[b][1] - in[a][1];
+                    if (id[b] == 0 && (dx * dx + dy * dy) <= radius_m * radius_m) {
+                        id[b] = next_id;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+    std::vector<std::array<double, 3U>> accum(static_cast<std::size_t>(next_id), {0.0, 0.0, 0.0});
+    for (std::size_t i = 0; i < n; ++i) {
+        auto& a = accum[static_cast<std::size_t>(id[i] - 1)];
+        a[0] += in[i][0];
+        a[1] += in[i][1];
+        a[2] += 1.0;
+    }
+    std::vector<Point> out;
+    for (const auto& a : accum) {
+        out.push_back({a[0] / a[2], a[1] / a[2]});
+    }
+    return out;
+}
+
+TEST(ClusteringTest, MatchesDenseFloodFillExactly) {
+    std::mt19937 rng(7U);
+    std::uniform_real_distribution<double> coord(-5.0, 5.0);
+    ultrasound::DetectionClusterer clusterer;
+    std::vector<Point> actual;
+
+    for (const std::size_t n : {0U, 1U, 17U, 150U, 600U}) {
+        for (const double radius : {0.0, 0.25, 0.45}) {
+            std::vector<Point> in;
+            for (std::size_t i = 0; i < n; ++i) {
+                in.push_back({coord(rng), coord(rng)});
+            }
+            clusterer.cluster(in, radius, actual);
+            const auto expected = cluster_dense(in, radius);
+            ASSERT_EQ(actual.size(), expected.size()) << "n=" << n << " radius=" << radius;
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_EQ(actual[i][0], expected[i][0]);
+                EXPECT_EQ(actual[i][1], expected[i][1]);
+            }
+        }
+    }
+}
+
+TEST(ClusteringTest, ChainsMergeAcrossLaterMembers) {
+    // 0 and 2 only connect through 3, which arrives last.
+    const std::vector<Point> in{{0.0, 0.0}, {5.0, 5.0}, {0.8, 0.0}, {0.4, 0.0}};
+    ultrasound::DetectionClusterer clusterer;
+    std::vector<Point> out;
+    clusterer.cluster(in, 0.45, out);
+    ASSERT_EQ(out.size(), 2U);
+    EXPECT_DOUBLE_EQ(out[0][0], 0.4);
+    EXPECT_DOUBLE_EQ(out[0][1], 0.0);
+    EXPECT_DOUBLE_EQ(out[1][0], 5.0);
+}
+
+}  // namespace
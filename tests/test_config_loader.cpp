@@ -22,6 +22,9 @@ TEST(ConfigLoaderTest, LoadsProcessorConfigFromIni) {
         out << "minRangeM=0.1\n";
         out << "maxRangeM=6.2\n";
         out << "strictMonotonicTimestamps=false\n";
+        out << "workerThreads=3\n";
+        out << "parallelPairThreshold=16\n";
+        out << "vehicleStateChannelCapacity=32\n";
         out << "[Conversion]\n";
         out << "nSigmaValeo=4.5\n";
         out << "legacyValeoBugfix=true\n";
@@ -29,6 +32,16 @@ TEST(ConfigLoaderTest, LoadsProcessorConfigFromIni) {
         out << "groupID=REAR\n";
         out << "method=FOV_INTERSECTION\n";
         out << "clusterRadiusM=0.7\n";
+        out << "intersectionSolver=ANALYTIC\n";
+        out << "skipConfocalPairs=false\n";
+        out << "pruneCrossGroupPairs=true\n";
+        out << "maxPairSensorGap=2\n";
+        out << "lutResolution=40\n";
+        out << "lutNewtonPolish=false\n";
+        out << "lutCachePath=cache/uss.lut\n";
+        out << "pairCacheCapacity=128\n";
+        out << "pairCacheQuantizationM=0.005\n";
+        out << "reuseUnchangedFrames=false\n";
     }
 
     ultrasound::ProcessorConfig cfg;
@@ -43,6 +56,19 @@ TEST(ConfigLoaderTest, LoadsProcessorConfigFromIni) {
     EXPECT_FLOAT_EQ(cfg.min_range_m, 0.1F);
     EXPECT_FLOAT_EQ(cfg.max_range_m, 6.2F);
     EXPECT_FLOAT_EQ(cfg.cluster_radius_m, 0.7F);
+    EXPECT_EQ(cfg.intersection_solver, ultrasound::IntersectionSolver::Analytic);
+    EXPECT_FALSE(cfg.skip_confocal_pairs);
+    EXPECT_TRUE(cfg.prune_cross_group_pairs);
+    EXPECT_EQ(cfg.max_pair_sensor_gap, 2U);
+    EXPECT_EQ(cfg.lut_resolution, 40U);
+    EXPECT_FALSE(cfg.lut_newton_polish);
+    EXPECT_EQ(cfg.lut_cache_path, "cache/uss.lut");
+    EXPECT_EQ(cfg.pair_cache_capacity, 128U);
+    EXPECT_FLOAT_EQ(cfg.pair_cache_quantization_m, 0.005F);
+    EXPECT_FALSE(cfg.reuse_unchanged_frames);
+    EXPECT_EQ(cfg.worker_threads, 3U);
+    EXPECT_EQ(cfg.parallel_pair_threshold, 16U);
+    EXPECT_EQ(cfg.vehicle_state_channel_capacity, 32U);
     EXPECT_FALSE(cfg.strict_monotonic_timestamps);
 }
 
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/ellipse_intersection.hpp"
+#include "ultrasound/ellipse_kernel.hpp"
+
+namespace {
+
+using ultrasound::EllipseModel;
+using ultrasound::EllipsePairSolution;
+
+double distance(const std::array<double, 2U>& a, const std::array<double, 2U>& b) {
+    return std::hypot(a[0] - b[0], a[1] - b[1]);
+}
+
+double nearest(const std::array<double, 2U>& p, const EllipsePairSolution& solution) {
+    double best = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < solution.point_count; ++i) {
+        best = std::min(best, distance(p, solution.points[i]));
+    }
+    return best;
+}
+
+TEST(EllipseIntersectionTest, AnalyticMatchesSampledRoots) {
+    const std::vector<std::array<EllipseModel, 2U>> pairs{
+        std::array<EllipseModel, 2U>{EllipseModel{3.4, 0.8, 2.0, 1.98, -0.5}, EllipseModel{3.7, 0.5, 2.1, 2.07, -0.3}},
+        std::array<EllipseModel, 2U>{EllipseModel{0.0, 0.0, 2.0, 1.0, 0.0}, EllipseModel{0.5, 0.2, 1.5, 1.2, 0.7}},
+        std::array<EllipseModel, 2U>{EllipseModel{0.0, 0.0, 1.5, 1.5, 0.0}, EllipseModel{2.0, 0.0, 1.0, 1.0, 0.0}},
+        std::array<EllipseModel, 2U>{EllipseModel{-1.0, 0.3, 2.5, 0.8, 1.2}, EllipseModel{0.4, -0.2, 1.9, 1.1, -0.4}},
+    };
+
+    for (const auto& pair : pairs) {
+        std::vector<std::array<double, 2U>> sampled;
+        ultrasound::sample_ellipse_intersections(pair[0], pair[1], sampled);
+
+        EllipsePairSolution analytic;
+        ASSERT_TRUE(ultrasound::solve_ellipse_intersections(pair[0], pair[1], analytic));
+        ASSERT_FALSE(sampled.empty());
+        EXPECT_EQ(analytic.point_count, sampled.size());
+        for (const auto& p : sampled) {
+            EXPECT_LT(nearest(p, analytic), 1.0e-3);
+        }
+        for (std::size_t i = 0; i < analytic.point_count; ++i) {
+            const auto& p = analytic.points[i];
+            EXPECT_NEAR(ultrasound::ellipse_implicit_value(pair[0], p[0], p[1]), 0.0, 1.0e-9);
+            EXPECT_NEAR(ultrasound::ellipse_implicit_value(pair[1], p[0], p[1]), 0.0, 1.0e-9);
+        }
+    }
+}
+
+TEST(EllipseIntersectionTest, DisjointPairReportsClosestApproach) {
+    const EllipseModel a{0.0, 0.0, 1.0, 1.0, 0.0};
+    const EllipseModel b{2.2, 0.0, 1.0, 1.0, 0.0};
+
+    EllipsePairSolution solution;
+    ASSERT_TRUE(ultrasound::solve_ellipse_intersections(a, b, solution));
+    EXPECT_EQ(solution.point_count, 0U);
+    EXPECT_NEAR(solution.closest_point[0], 1.0, 1.0e-9);
+    EXPECT_NEAR(solution.closest_point[1], 0.0, 1.0e-9);
+    EXPECT_NEAR(solution.closest_error, ultrasound::ellipse_implicit_error(b, 1.0, 0.0), 1.0e-9);
+}
+
+TEST(EllipseIntersectionTest, DegeneratePairsRequestFallback) {
+    const EllipseModel a{1.0, -0.5, 2.0, 1.5, 0.3};
+    EllipsePairSolution solution;
+    EXPECT_FALSE(ultrasound::solve_ellipse_intersections(a, a, solution));
+
+    const EllipseModel inner{0.0, 0.0, 1.0, 1.0, 0.0};
+    const EllipseModel outer{0.0, 0.0, 2.0, 2.0, 0.4};
+    EXPECT_FALSE(ultrasound::solve_ellipse_intersections(inner, outer, solution));
+}
+
+TEST(EllipseIntersectionTest, CircleKernelsMatchSampledRoots) {
+    const std::vector<std::array<EllipseModel, 2U>> pairs{
+        std::array<EllipseModel, 2U>{EllipseModel{0.0, 0.0, 1.5, 1.5, 0.3}, EllipseModel{2.0, 0.4, 1.0, 1.0, -1.1}},
+        std::array<EllipseModel, 2U>{EllipseModel{3.6, 0.7, 2.2, 2.2, 0.66}, EllipseModel{3.8, -0.3, 1.9, 1.9, -0.07}},
+        std::array<EllipseModel, 2U>{EllipseModel{0.0, 0.0, 1.2, 1.2, 0.0}, EllipseModel{0.5, 0.2, 2.0, 0.9, 0.7}},
+        std::array<EllipseModel, 2U>{EllipseModel{0.5, 0.2, 2.0, 0.9, 0.7}, EllipseModel{0.0, 0.0, 1.2, 1.2, 0.0}},
+        std::array<EllipseModel, 2U>{EllipseModel{-1.0, 0.3, 2.5, 0.8, 1.2}, EllipseModel{0.4, -0.2, 1.4, 1.4, 2.0}},
+    };
+
+    for (const auto& pair : pairs) {
+        std::vector<std::array<double, 2U>> sampled;
+        ultrasound::sample_ellipse_intersections(pair[0], pair[1], sampled);
+
+        EllipsePairSolution solution;
+        ASSERT_TRUE(ultrasound::solve_ellipse_intersections(pair[0], pair[1], solution));
+        ASSERT_FALSE(sampled.empty());
+        EXPECT_EQ(solution.point_count, sampled.size());
+        for (const auto& p : sampled) {
+            EXPECT_LT(nearest(p, solution), 1.0e-3);
+        }
+        for (std::size_t i = 0; i < solution.point_count; ++i) {
+            const auto& p = solution.points[i];
+            EXPECT_NEAR(ultrasound::ellipse_implicit_value(pair[0], p[0], p[1]), 0.0, 1.0e-9);
+            EXPECT_NEAR(ultrasound::ellipse_implicit_value(pair[1], p[0], p[1]), 0.0, 1.0e-9);
+        }
+    }
+}
+
+TEST(EllipseIntersectionTest, CircleCircleClosestApproachAndTangency) {
+    // b inside a: the closest point of a to b's boundary is on the near side.
+    const EllipseModel a{0.0, 0.0, 3.0, 3.0, 0.0};
+    const EllipseModel b{1.0, 0.0, 1.0, 1.0, 0.0};
+    EllipsePairSolution solution;
+    ASSERT_TRUE(ultrasound::solve_circle_circle(a, b, solution));
+    EXPECT_EQ(solution.point_count, 0U);
+    EXPECT_NEAR(solution.closest_point[0], 3.0, 1.0e-12);
+    EXPECT_NEAR(solution.closest_point[1], 0.0, 1.0e-12);
+    EXPECT_NEAR(solution.closest_error, ultrasound::ellipse_implicit_error(b, 3.0, 0.0), 1.0e-12);
+
+    // a inside b: the far side of a is closest to b's boundary.
+    ASSERT_TRUE(ultrasound::solve_circle_circle(b, a, solution));
+    EXPECT_EQ(solution.point_count, 0U);
+    EXPECT_NEAR(solution.closest_point[0], 2.0, 1.0e-12);
+    EXPECT_NEAR(solution.closest_error, ultrasound::ellipse_implicit_error(a, 2.0, 0.0), 1.0e-12);
+
+    const EllipseModel touching{2.5, 0.0, 1.5, 1.5, 0.0};
+    const EllipseModel unit{0.0, 0.0, 1.0, 1.0, 0.0};
+    ASSERT_TRUE(ultrasound::solve_circle_circle(unit, touching, solution));
+    ASSERT_EQ(solution.point_count, 1U);
+    EXPECT_NEAR(solution.points[0][0], 1.0, 1.0e-12);
+    EXPECT_NEAR(solution.points[0][1], 0.0, 1.0e-12);
+}
+
+// Differential test against the fixed 360-sample sampler: same roots at equal accuracy, far fewer evaluations.
+TEST(EllipseIntersectionTest, AdaptiveMatchesFixedSamplerWithFewerEvaluations) {
+    std::mt19937 rng(17U);
+    std::uniform_real_distribution<double> coord(-3.0, 3.0);
+    std::uniform_real_distribution<double> axis(0.2, 4.0);
+    std::uniform_real_distribution<double> angle(-3.2, 3.2);
+
+    std::size_t fixed_evaluations = 0U;
+    std::size_t adaptive_evaluations = 0U;
+    std::size_t with_roots = 0U;
+    for (int trial = 0; trial < 2000; ++trial) {
+        const double r = axis(rng);
+        const EllipseModel a{coord(rng), coord(rng), axis(rng), axis(rng), angle(rng)};
+        const EllipseModel b{coord(rng), coord(rng), r, (trial % 3 == 0) ? r : axis(rng), angle(rng)};
+        const auto pa = ultrasound::prepare_ellipse(a);
+        const auto pb = ultrasound::prepare_ellipse(b);
+
+        ultrasound::EllipseSampleBlock block;
+        ultrasound::sample_ellipse(pa, block);
+        std::vector<std::array<double, 2U>> sampled;
+        ultrasound::sample_ellipse_intersections(pa, block, pb, sampled);
+        // 361 batched samples plus 20 bisection steps per bracket.
+        fixed_evaluations += ultrasound::kEllipseSamples + 1U + 20U * sampled.size();
+
+        EllipsePairSolution adaptive;
+        std::size_t evaluations = 0U;
+        ASSERT_TRUE(ultrasound::adaptive_ellipse_intersections(pa, pb, adaptive, &evaluations));
+        adaptive_evaluations += evaluations;
+        ASSERT_EQ(adaptive.point_count, sampled.size()) << "trial " << trial;
+        with_roots += sampled.empty() ? 0U : 1U;
+        for (const auto& p : sampled) {
+            EXPECT_LT(nearest(p, adaptive), 1.0e-6);
+        }
+        for (std::size_t i = 0; i < adaptive.point_count; ++i) {
+            const auto& p = adaptive.points[i];
+            EXPECT_NEAR(ultrasound::ellipse_implicit_value(b, p[0], p[1]), 0.0, 1.0e-9);
+        }
+        if (sampled.empty()) {
+            EXPECT_LE(adaptive.closest_error, ultrasound::ellipse_implicit_error(b, block.x[0], block.y[0]));
+        }
+    }
+    EXPECT_GT(with_roots, 500U);
+    EXPECT_GE(fixed_evaluations, 5U * adaptive_evaluations);
+}
+
+TEST(EllipseIntersectionTest, AdaptiveFindsRootPairInsideOneCoarseInterval) {
+    // A small circle clipping a large one near 25 degrees: both crossings fall inside the coarse interval [20, 30].
+    const auto a = ultrasound::prepare_ellipse(EllipseModel{0.0, 0.0, 4.0, 4.0, 0.0});
+    const auto b = ultrasound::prepare_ellipse(EllipseModel{3.6705, 1.7116, 0.1, 0.1, 0.0});
+    EllipsePairSolution solution;
+    ASSERT_TRUE(ultrasound::adaptive_ellipse_intersections(a, b, solution));
+    ASSERT_EQ(solution.point_count, 2U);
+    EllipsePairSolution exact;
+    ASSERT_TRUE(ultrasound::solve_circle_circle(a.model, b.model, exact));
+    ASSERT_EQ(exact.point_count, 2U);
+    for (std::size_t i = 0; i < exact.point_count; ++i) {
+        EXPECT_LT(nearest(exact.points[i], solution), 1.0e-8);
+    }
+
+    EXPECT_FALSE(ultrasound::adaptive_ellipse_intersections(a, a, solution));
+}
+
+}  // namespace
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/ellipse_kernel.hpp"
+
+namespace {
+
+using ultrasound::EllipseModel;
+
+TEST(EllipseKernelTest, BatchMatchesScalarBitForBit) {
+    std::mt19937 rng(11U);
+    std::uniform_real_distribution<double> coord(-8.0, 8.0);
+    std::uniform_real_distribution<double> axis(0.0, 5.0);
+    std::uniform_real_distribution<double> angle(-3.2, 3.2);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const EllipseModel e{coord(rng), coord(rng), axis(rng), axis(rng), angle(rng)};
+        const auto prepared = ultrasound::prepare_ellipse(e);
+        // Odd counts exercise the scalar tail after the vector body.
+        const std::size_t count = 1U + static_cast<std::size_t>(trial) % 37U;
+        std::vector<double> x(count);
+        std::vector<double> y(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            x[i] = coord(rng);
+            y[i] = coord(rng);
+        }
+        std::vector<double> batch(count);
+        std::vector<double> scalar(count);
+        ultrasound::ellipse_implicit_values(prepared, x.data(), y.data(), batch.data(), count);
+        ultrasound::ellipse_implicit_values_scalar(prepared, x.data(), y.data(), scalar.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(batch[i], scalar[i]);
+            EXPECT_EQ(scalar[i], ultrasound::ellipse_implicit_value(e, x[i], y[i]));
+        }
+    }
+}
+
+TEST(EllipseKernelTest, TableSamplesMatchEllipsePointBitForBit) {
+    const EllipseModel e{1.5, -0.4, 2.2, 0.9, 0.7};
+    const auto prepared = ultrasound::prepare_ellipse(e);
+    ultrasound::EllipseSampleBlock block;
+    ultrasound::sample_ellipse(prepared, block);
+    for (std::size_t s = 0; s <= ultrasound::kEllipseSamples; ++s) {
+        const double t = (static_cast<double>(s) / static_cast<double>(ultrasound::kEllipseSamples)) *
+                         (2.0 * 3.14159265358979323846);
+        const auto p = ultrasound::ellipse_point(e, t);
+        EXPECT_EQ(block.x[s], p[0]);
+        EXPECT_EQ(block.y[s], p[1]);
+        EXPECT_EQ(ultrasound::ellipse_point(prepared, t), p);
+    }
+
+    std::array<double, ultrasound::kEllipseSamples + 1U> values{};
+    ultrasound::ellipse_implicit_values(prepared, block.x.data(), block.y.data(), values.data(), values.size());
+    for (const double v : values) {
+        EXPECT_NEAR(v, 0.0, 1.0e-12);
+    }
+}
+
+TEST(EllipseKernelTest, BoundingBoxIsTight) {
+    const EllipseModel e{-2.0, 3.0, 2.5, 1.2, -1.1};
+    const auto prepared = ultrasound::prepare_ellipse(e);
+    ultrasound::EllipseSampleBlock block;
+    ultrasound::sample_ellipse(prepared, block);
+    double min_x = block.x[0];
+    double max_x = block.x[0];
+    double min_y = block.y[0];
+    double max_y = block.y[0];
+    for (std::size_t s = 0; s <= ultrasound::kEllipseSamples; ++s) {
+        EXPECT_GE(block.x[s], prepared.min_x_m - 1.0e-12);
+        EXPECT_LE(block.x[s], prepared.max_x_m + 1.0e-12);
+        EXPECT_GE(block.y[s], prepared.min_y_m - 1.0e-12);
+        EXPECT_LE(block.y[s], prepared.max_y_m + 1.0e-12);
+        min_x = std::min(min_x, block.x[s]);
+        max_x = std::max(max_x, block.x[s]);
+        min_y = std::min(min_y, block.y[s]);
+        max_y = std::max(max_y, block.y[s]);
+    }
+    // 1-degree sampling gets within 1 - cos(0.5 deg) of each extreme.
+    EXPECT_NEAR(min_x, prepared.min_x_m, 1.0e-3);
+    EXPECT_NEAR(max_x, prepared.max_x_m, 1.0e-3);
+    EXPECT_NEAR(min_y, prepared.min_y_m, 1.0e-3);
+    EXPECT_NEAR(max_y, prepared.max_y_m, 1.0e-3);
+}
+
+TEST(EllipseKernelTest, CircleImplicitRangeBoundsEverySample) {
+    std::mt19937 rng(23U);
+    std::uniform_real_distribution<double> coord(-4.0, 4.0);
+    std::uniform_real_distribution<double> axis(0.1, 4.0);
+    std::uniform_real_distribution<double> angle(-3.2, 3.2);
+
+    double lo = 0.0;
+    double hi = 0.0;
+    const auto ellipse = ultrasound::prepare_ellipse(EllipseModel{0.0, 0.0, 2.0, 1.0, 0.3});
+    EXPECT_FALSE(ultrasound::circle_implicit_range(ellipse, ellipse, lo, hi));
+
+    ultrasound::EllipseSampleBlock block;
+    std::array<double, ultrasound::kEllipseSamples + 1U> values{};
+    for (int trial = 0; trial < 400; ++trial) {
+        const double r = axis(rng);
+        const double a_axis = axis(rng);
+        const EllipseModel a{coord(rng), coord(rng), a_axis, (trial % 2 == 0) ? a_axis : axis(rng), angle(rng)};
+        const EllipseModel b{coord(rng), coord(rng), r, r, angle(rng)};
+        const auto pa = ultrasound::prepare_ellipse(a);
+        const auto pb = ultrasound::prepare_ellipse(b);
+        EXPECT_EQ(pa.circle, trial % 2 == 0);
+        ASSERT_TRUE(ultrasound::circle_implicit_range(pa, pb, lo, hi));
+        ultrasound::sample_ellipse(pa, block);
+        ultrasound::ellipse_implicit_values(pb, block.x.data(), block.y.data(), values.data(), values.size());
+        for (const double v : values) {
+            EXPECT_GE(v, lo);
+            EXPECT_LE(v, hi);
+        }
+    }
+}
+
+}  // namespace
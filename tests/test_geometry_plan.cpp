@@ -0,0 +1,221 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/processor.hpp"
+
+namespace {
+
+using ultrasound::FrameInput;
+using ultrasound::ProcessingMethod;
+using ultrasound::ProcessorConfig;
+using ultrasound::UltrasoundProcessor;
+using ultrasound::VehicleGeometry;
+using ultrasound::VehicleState;
+
+VehicleGeometry reference_geometry() {
+    VehicleGeometry g;
+    g.contour = {{-0.775F, 0.822F}, {-0.956F, 0.71F}, {-1.09F, 0.25F}, {-1.09F, -0.25F},
+                 {-0.956F, -0.71F}, {-0.775F, -0.822F}, {3.238F, -0.913F}, {3.6F, -0.715F},
+                 {3.804F, -0.276F}, {3.804F, 0.276F}, {3.6F, 0.715F}, {3.238F, 0.913F}};
+    g.sensors = {{3.238F, 0.913F, 87.0F, 60.0F},    {3.6F, 0.715F, 38.0F, 100.0F},
+                 {3.804F, 0.276F, 7.0F, 100.0F},    {3.804F, -0.276F, -4.0F, 75.0F},
+                 {3.6F, -0.715F, -28.0F, 75.0F},    {3.238F, -0.913F, -87.0F, 45.0F},
+                 {-0.775F, -0.822F, -100.0F, 75.0F}, {-0.956F, -0.71F, -165.0F, 75.0F},
+                 {-1.09F, -0.25F, -175.0F, 75.0F},  {-1.09F, 0.25F, 173.0F, 100.0F},
+                 {-0.956F, 0.71F, 151.0F, 100.0F},  {-0.775F, 0.822F, 99.0F, 100.0F}};
+    return g;
+}
+
+void seed_state(UltrasoundProcessor& p) {
+    VehicleState s;
+    s.timestamp_us = 1000U;
+    ASSERT_TRUE(p.push_vehicle_state(s).is_ok());
+}
+
+FrameInput sample_frame() {
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 2.0F, 0U, 0U});
+    in.signal_ways.push_back({1500U, 2.1F, 0U, 4U});
+    in.signal_ways.push_back({1500U, 1.7F, 1U, 9U});
+    return in;
+}
+
+TEST(GeometryPlanTest, DefaultPlanIsSharedAcrossProcessors) {
+    UltrasoundProcessor p0;
+    UltrasoundProcessor p1;
+    EXPECT_EQ(p0.geometry_plan().get(), p1.geometry_plan().get());
+    EXPECT_EQ(p0.geometry_plan().get(), ultrasound::default_geometry_plan().get());
+
+    const auto& plan = *p0.geometry_plan();
+    EXPECT_EQ(plan.sensor_x_m.size(), 12U);
+    EXPECT_EQ(plan.edge_x0.size(), 12U);
+    EXPECT_DOUBLE_EQ(plan.contour_min_x_m, -1.09);
+    EXPECT_DOUBLE_EQ(plan.contour_max_x_m, 3.804);
+}
+
+TEST(GeometryPlanTest, CompiledPlanIsSharedNotCopied) {
+    const auto plan = ultrasound::compile_geometry_plan(reference_geometry());
+    const auto uses_before = plan.use_count();
+    UltrasoundProcessor p0(ProcessorConfig{}, plan);
+    UltrasoundProcessor p1(ProcessorConfig{}, plan);
+    EXPECT_EQ(plan.use_count(), uses_before + 2);
+    EXPECT_EQ(p0.geometry_plan().get(), plan.get());
+    EXPECT_EQ(p1.geometry_plan().get(), plan.get());
+}
+
+TEST(GeometryPlanTest, ContourContainment) {
+    const auto plan = ultrasound::default_geometry_plan();
+    EXPECT_TRUE(ultrasound::is_inside_vehicle_contour(*plan, 1.0, 0.0));
+    EXPECT_TRUE(ultrasound::is_inside_vehicle_contour(*plan, 3.7, 0.2));
+    EXPECT_FALSE(ultrasound::is_inside_vehicle_contour(*plan, 4.0, 0.0));
+    EXPECT_FALSE(ultrasound::is_inside_vehicle_contour(*plan, 1.0, 0.95));
+    EXPECT_FALSE(ultrasound::is_inside_vehicle_contour(*plan, 3.75, 0.7));
+}
+
+TEST(GeometryPlanTest, ReferenceGeometryMatchesBuiltInVehicle) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::All;
+    UltrasoundProcessor builtin(cfg);
+    UltrasoundProcessor configured(cfg, reference_geometry());
+    seed_state(builtin);
+    seed_state(configured);
+
+    ASSERT_TRUE(builtin.process_frame(sample_frame()).is_ok());
+    ASSERT_TRUE(configured.process_frame(sample_frame()).is_ok());
+    const auto a = builtin.last_output();
+    const auto b = configured.last_output();
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    ASSERT_EQ(a->processed.tracing.size(), b->processed.tracing.size());
+    for (std::size_t i = 0; i < a->processed.tracing.size(); ++i) {
+        EXPECT_NEAR(a->processed.tracing[i][0], b->processed.tracing[i][0], 1.0e-5);
+        EXPECT_NEAR(a->processed.tracing[i][1], b->processed.tracing[i][1], 1.0e-5);
+    }
+}
+
+TEST(GeometryPlanTest, VehicleVariantMovesDetections) {
+    auto variant = reference_geometry();
+    for (auto& s : variant.sensors) {
+        s.x_m += 0.5F;
+    }
+    for (auto& c : variant.contour) {
+        c.x_m += 0.5F;
+    }
+
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::SignalTracing;
+    UltrasoundProcessor reference(cfg, reference_geometry());
+    UltrasoundProcessor shifted(cfg, variant);
+    seed_state(reference);
+    seed_state(shifted);
+
+    ASSERT_TRUE(reference.process_frame(sample_frame()).is_ok());
+    ASSERT_TRUE(shifted.process_frame(sample_frame()).is_ok());
+    const auto a = reference.last_output();
+    const auto b = shifted.last_output();
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    ASSERT_EQ(a->processed.tracing.size(), b->processed.tracing.size());
+    for (std::size_t i = 0; i < a->processed.tracing.size(); ++i) {
+        EXPECT_NEAR(b->processed.tracing[i][0] - a->processed.tracing[i][0], 0.5, 1.0e-5);
+        EXPECT_NEAR(b->processed.tracing[i][1], a->processed.tracing[i][1], 1.0e-5);
+    }
+}
+
+TEST(GeometryPlanTest, MissingSensorsInvalidateTheirSignalWays) {
+    VehicleGeometry front_only = reference_geometry();
+    front_only.sensors.resize(6U);
+    const auto plan = ultrasound::compile_geometry_plan(front_only);
+
+    EXPECT_NE(ultrasound::find_sensor_pair(plan->pairs, 0U, 15U), nullptr);
+    EXPECT_EQ(ultrasound::find_sensor_pair(plan->pairs, 1U, 0U), nullptr);
+    EXPECT_EQ(ultrasound::find_sensor_pair(plan->pairs, 0U, 16U), nullptr);
+
+    const auto* pair = ultrasound::find_sensor_pair(plan->pairs, 0U, 4U);
+    ASSERT_NE(pair, nullptr);
+    EXPECT_EQ(pair->tx, 1U);
+    EXPECT_EQ(pair->rx, 2U);
+    EXPECT_FALSE(pair->monostatic);
+}
+
+// Front sensors 0-5 and rear sensors 6-11 form two chains; the long sides between them are not links.
+TEST(GeometryPlanTest, SensorGapsFollowNeighbouringSensors) {
+    const auto plan = ultrasound::default_geometry_plan();
+    const std::size_t n = plan->sensor_x_m.size();
+    ASSERT_EQ(n, 12U);
+    ASSERT_EQ(plan->sensor_gaps.size(), n * n);
+    const auto gap = [&](std::size_t a, std::size_t b) { return plan->sensor_gaps[a * n + b]; };
+    EXPECT_EQ(gap(0U, 0U), 0U);
+    EXPECT_EQ(gap(0U, 1U), 1U);
+    EXPECT_EQ(gap(5U, 0U), 5U);
+    EXPECT_EQ(gap(6U, 11U), 5U);
+    EXPECT_EQ(gap(8U, 10U), 2U);
+    EXPECT_EQ(gap(5U, 6U), ultrasound::GeometryPlan::kNoSensorPath);
+    EXPECT_EQ(gap(11U, 0U), ultrasound::GeometryPlan::kNoSensorPath);
+    EXPECT_EQ(gap(2U, 9U), ultrasound::GeometryPlan::kNoSensorPath);
+}
+
+// Every lookup path must agree with the crossing-number test, including points on and hugging edges.
+void expect_raster_matches_crossing_number(const ultrasound::GeometryPlan& plan,
+                                           const std::vector<ultrasound::ContourPoint>& contour,
+                                           unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> jitter_exp(-12.0, -2.0);
+    const double pad = 0.5;
+    std::size_t checked = 0U;
+    for (int i = 0; i < 20000; ++i) {
+        const double x = plan.contour_min_x_m - pad + unit(rng) * (plan.contour_max_x_m - plan.contour_min_x_m + 2.0 * pad);
+        const double y = plan.contour_min_y_m - pad + unit(rng) * (plan.contour_max_y_m - plan.contour_min_y_m + 2.0 * pad);
+        EXPECT_EQ(ultrasound::is_inside_vehicle_contour(plan, x, y), ultrasound::is_inside_vehicle_contour_exact(plan, x, y));
+        ++checked;
+    }
+    for (std::size_t k = 0; k < contour.size(); ++k) {
+        const auto& a = contour[k];
+        const auto& b = contour[(k + 1U) % contour.size()];
+        for (int i = 0; i < 2000; ++i) {
+            const double t = (i % 50 == 0) ? 0.0 : unit(rng);
+            const double off = ((i % 2 == 0) ? 1.0 : -1.0) * std::pow(10.0, jitter_exp(rng));
+            const double ex = static_cast<double>(b.x_m) - static_cast<double>(a.x_m);
+            const double ey = static_cast<double>(b.y_m) - static_cast<double>(a.y_m);
+            const double len = std::hypot(ex, ey);
+            const double x = static_cast<double>(a.x_m) + t * ex - off * ey / len;
+            const double y = static_cast<double>(a.y_m) + t * ey + off * ex / len;
+            EXPECT_EQ(ultrasound::is_inside_vehicle_contour(plan, x, y),
+                      ultrasound::is_inside_vehicle_contour_exact(plan, x, y))
+                << "edge " << k << " at (" << x << ", " << y << ")";
+            ++checked;
+        }
+    }
+    EXPECT_GT(checked, 20000U);
+}
+
+TEST(GeometryPlanTest, ContourRasterMatchesCrossingNumber) {
+    const auto geometry = reference_geometry();
+    const auto plan = ultrasound::compile_geometry_plan(geometry);
+    ASSERT_FALSE(plan->contour_cells.empty());
+    expect_raster_matches_crossing_number(*plan, geometry.contour, 5U);
+}
+
+TEST(GeometryPlanTest, ContourRasterMatchesCrossingNumberOnConcaveContour) {
+    // Star-shaped outline with deep notches and a horizontal edge.
+    VehicleGeometry star = reference_geometry();
+    star.contour.clear();
+    for (int k = 0; k < 14; ++k) {
+        const double angle = static_cast<double>(k) * (2.0 * 3.14159265358979323846 / 14.0);
+        const double r = (k % 2 == 0) ? 2.0 : 0.7;
+        star.contour.push_back({static_cast<float>(1.2 + r * std::cos(angle)), static_cast<float>(r * std::sin(angle))});
+    }
+    star.contour.push_back({star.contour.back().x_m - 0.4F, star.contour.back().y_m});
+    const auto plan = ultrasound::compile_geometry_plan(star);
+    ASSERT_FALSE(plan->contour_cells.empty());
+    EXPECT_TRUE(ultrasound::is_inside_vehicle_contour(*plan, 1.2, 0.0));
+    expect_raster_matches_crossing_number(*plan, star.contour, 9U);
+}
+
+}  // namespace
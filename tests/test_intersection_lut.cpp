@@ -0,0 +1,171 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/ellipse_kernel.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/intersection_lut.hpp"
+#include "ultrasound/intersection_lut_io.hpp"
+#include "ultrasound/pair_candidates.hpp"
+
+namespace {
+
+using ultrasound::EllipsePairSolution;
+using ultrasound::IntersectionLut;
+using ultrasound::ModelOrigin;
+using ultrasound::SensorPairGeometry;
+
+double distance_to_nearest(const EllipsePairSolution& s, const std::array<double, 2U>& p) {
+    double best = 1.0e9;
+    for (std::size_t k = 0; k < s.point_count; ++k) {
+        best = std::min(best, std::hypot(s.points[k][0] - p[0], s.points[k][1] - p[1]));
+    }
+    return best;
+}
+
+ModelOrigin origin_of(const SensorPairGeometry& pair) {
+    return ultrasound::make_model_origin(0U, pair.tx, pair.rx);
+}
+
+TEST(IntersectionLutTest, LookupMatchesClosedFormRoots) {
+    const auto plan = ultrasound::default_geometry_plan();
+    const auto lut = ultrasound::build_intersection_lut(*plan, 0.2, 5.5, 32U);
+    ASSERT_GT(lut->foci_count, 0U);
+    EXPECT_TRUE(ultrasound::intersection_lut_matches(*lut, *plan, 0.2, 5.5, 32U));
+    EXPECT_FALSE(ultrasound::intersection_lut_matches(*lut, *plan, 0.2, 5.5, 48U));
+
+    std::mt19937 rng(17U);
+    std::uniform_int_distribution<int> way(0, 15);
+    std::uniform_int_distribution<int> group(0, 1);
+    std::uniform_real_distribution<double> range(0.3, 5.4);
+    std::size_t solvable = 0U;
+    std::size_t answered = 0U;
+    std::size_t close_raw = 0U;
+    std::size_t raw_roots = 0U;
+    for (int trial = 0; trial < 4000; ++trial) {
+        const auto g = static_cast<std::uint8_t>(group(rng));
+        const auto* pa = ultrasound::find_sensor_pair(plan->pairs, g, static_cast<std::uint8_t>(way(rng)));
+        const auto* pb = ultrasound::find_sensor_pair(plan->pairs, g, static_cast<std::uint8_t>(way(rng)));
+        const double ra = range(rng);
+        const double rb = range(rng);
+        const auto ea = ultrasound::signal_way_ellipse(*pa, ra);
+        const auto eb = ultrasound::signal_way_ellipse(*pb, rb);
+        EllipsePairSolution exact;
+        if (!ea.has_value() || !eb.has_value() || !ultrasound::solve_ellipse_intersections(*ea, *eb, exact) ||
+            exact.point_count == 0U) {
+            continue;
+        }
+        ++solvable;
+        EllipsePairSolution table;
+        if (!ultrasound::lookup_intersections(*lut, origin_of(*pa), ra, origin_of(*pb), rb, table)) {
+            continue;
+        }
+        ASSERT_EQ(table.point_count, exact.point_count);
+        const auto a = ultrasound::prepare_ellipse(*ea);
+        const auto b = ultrasound::prepare_ellipse(*eb);
+        bool settled = true;
+        for (std::size_t k = 0; k < table.point_count; ++k) {
+            auto p = table.points[k];
+            close_raw += distance_to_nearest(exact, p) < 0.05 ? 1U : 0U;
+            ++raw_roots;
+            if (ultrasound::polish_intersection(a, b, p)) {
+                EXPECT_LT(distance_to_nearest(exact, p), 1.0e-5);
+            } else {
+                settled = false;
+            }
+        }
+        answered += settled ? 1U : 0U;
+    }
+    // Unpolished interpolation is coarse where the ellipses cross at shallow angles; polish either settles a
+    // root onto the exact one or reports failure so the caller falls back.
+    EXPECT_GT(close_raw, raw_roots * 3U / 4U);
+    EXPECT_GT(answered, solvable * 7U / 10U);
+}
+
+TEST(IntersectionLutTest, UncoveredPairsFallBack) {
+    const auto plan = ultrasound::default_geometry_plan();
+    const auto lut = ultrasound::build_intersection_lut(*plan, 0.2, 5.5, 32U);
+    const auto* front = ultrasound::find_sensor_pair(plan->pairs, 0U, 4U);
+    ASSERT_NE(front, nullptr);
+    const SensorPairGeometry* front_reverse = nullptr;
+    for (std::uint8_t id = 0U; id < ultrasound::kSignalWaysPerGroup; ++id) {
+        const auto* p = ultrasound::find_sensor_pair(plan->pairs, 0U, id);
+        if (p != nullptr && p->tx == front->rx && p->rx == front->tx) {
+            front_reverse = p;
+        }
+    }
+    const auto* neighbour = ultrasound::find_sensor_pair(plan->pairs, 0U, 3U);
+    ASSERT_NE(front_reverse, nullptr);
+    ASSERT_NE(neighbour, nullptr);
+
+    EllipsePairSolution s;
+    EXPECT_TRUE(ultrasound::lookup_intersections(*lut, origin_of(*front), 1.5, origin_of(*neighbour), 1.4, s));
+    EXPECT_GT(s.point_count, 0U);
+    // Off the grid, confocal, and too far apart to meet.
+    EXPECT_FALSE(ultrasound::lookup_intersections(*lut, origin_of(*front), 5.8, origin_of(*neighbour), 1.4, s));
+    EXPECT_FALSE(ultrasound::lookup_intersections(*lut, origin_of(*front), 1.5, origin_of(*front_reverse), 1.4, s));
+    EXPECT_FALSE(ultrasound::lookup_intersections(*lut, origin_of(*front), 0.3, origin_of(*neighbour), 3.0, s));
+}
+
+TEST(IntersectionLutTest, CacheRoundTripAndRejectsMismatch) {
+    const auto path = std::filesystem::temp_directory_path() / "uss_intersection_lut_test.bin";
+    std::filesystem::remove(path);
+    const auto plan = ultrasound::default_geometry_plan();
+    ultrasound::ProcessorConfig cfg;
+    cfg.lut_resolution = 24U;
+    cfg.lut_cache_path = path.string();
+
+    std::shared_ptr<const IntersectionLut> built;
+    ASSERT_TRUE(ultrasound::load_or_build_intersection_lut(*plan, cfg, built).is_ok());
+    ASSERT_TRUE(std::filesystem::exists(path));
+
+    std::shared_ptr<const IntersectionLut> loaded;
+    ASSERT_TRUE(ultrasound::load_intersection_lut(path.string(), loaded).is_ok());
+    EXPECT_EQ(loaded->geometry_fingerprint, built->geometry_fingerprint);
+    EXPECT_EQ(loaded->resolution, 24U);
+    EXPECT_EQ(loaded->foci_index, built->foci_index);
+    EXPECT_EQ(loaded->table_index, built->table_index);
+    EXPECT_EQ(loaded->counts, built->counts);
+    EXPECT_EQ(loaded->points, built->points);
+
+    // A different grid rebuilds and overwrites the cache.
+    cfg.lut_resolution = 16U;
+    std::shared_ptr<const IntersectionLut> rebuilt;
+    ASSERT_TRUE(ultrasound::load_or_build_intersection_lut(*plan, cfg, rebuilt).is_ok());
+    EXPECT_EQ(rebuilt->resolution, 16U);
+    ASSERT_TRUE(ultrasound::load_intersection_lut(path.string(), loaded).is_ok());
+    EXPECT_EQ(loaded->resolution, 16U);
+
+    // Header sizes whose squares wrap to 0 (resolution after magic and fingerprint, then the sensor and foci
+    // counts after the three range fields) are rejected, not divided by.
+    for (const std::streamoff offset : {16, 48, 56}) {
+        ASSERT_TRUE(ultrasound::save_intersection_lut(*built, path.string()).is_ok());
+        {
+            std::fstream io(path, std::ios::binary | std::ios::in | std::ios::out);
+            const std::uint64_t corrupt = 1ULL << 32U;
+            io.seekp(offset);
+            io.write(reinterpret_cast<const char*>(&corrupt), sizeof(corrupt));
+        }
+        const auto st = ultrasound::load_intersection_lut(path.string(), loaded);
+        EXPECT_FALSE(st.is_ok()) << "offset " << offset;
+        EXPECT_NE(st.message.find("inconsistent"), std::string::npos) << st.message;
+    }
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "USSLUT01 truncated";
+    }
+    EXPECT_FALSE(ultrasound::load_intersection_lut(path.string(), loaded).is_ok());
+    std::filesystem::remove(path);
+    EXPECT_FALSE(ultrasound::load_intersection_lut(path.string(), loaded).is_ok());
+}
+
+}  // namespace
@@ -0,0 +1,90 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/pair_cache.hpp"
+
+namespace {
+
+using ultrasound::PairCacheKey;
+using ultrasound::PairIntersectionCache;
+using ultrasound::PairIntersections;
+
+PairIntersections value_of(std::uint64_t tag) {
+    PairIntersections v;
+    v.points.push_back({static_cast<double>(tag), -static_cast<double>(tag)});
+    v.deferred_begin = static_cast<std::size_t>(tag % 2U);
+    return v;
+}
+
+TEST(PairCacheTest, EvictsLeastRecentlyUsed) {
+    PairIntersectionCache cache(2U);
+    cache.insert({1U, 2U}, value_of(1U));
+    cache.insert({2U, 1U}, value_of(2U));
+    EXPECT_EQ(cache.size(), 2U);
+    ASSERT_NE(cache.find({1U, 2U}), nullptr);
+    cache.insert({3U, 4U}, value_of(3U));
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_EQ(cache.find({2U, 1U}), nullptr);
+    const auto* hit = cache.find({1U, 2U});
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(hit->points.front()[0], 1.0);
+    EXPECT_EQ(hit->deferred_begin, 1U);
+
+    cache.insert({3U, 4U}, value_of(4U));
+    EXPECT_EQ(cache.find({3U, 4U})->points.front()[0], 4.0);
+    cache.clear();
+    EXPECT_EQ(cache.find({3U, 4U}), nullptr);
+
+    PairIntersectionCache disabled;
+    disabled.insert({1U, 2U}, value_of(1U));
+    EXPECT_EQ(disabled.find({1U, 2U}), nullptr);
+}
+
+// Random traffic against a list-based LRU model exercises eviction and the slot deletion path.
+TEST(PairCacheTest, MatchesReferenceLru) {
+    constexpr std::size_t kCapacity = 37U;
+    PairIntersectionCache cache(kCapacity);
+    std::list<std::pair<std::uint64_t, std::uint64_t>> reference;
+    std::mt19937 rng(3U);
+    std::uniform_int_distribution<std::uint64_t> key(0U, 120U);
+    for (int step = 0; step < 20000; ++step) {
+        const std::uint64_t k = key(rng);
+        const PairCacheKey cache_key{k, k * 7U};
+        auto it = reference.begin();
+        while (it != reference.end() && it->first != k) {
+            ++it;
+        }
+        const auto* hit = cache.find(cache_key);
+        ASSERT_EQ(hit != nullptr, it != reference.end()) << "step " << step;
+        if (hit != nullptr) {
+            EXPECT_EQ(hit->points.front()[0], static_cast<double>(it->second));
+            reference.splice(reference.begin(), reference, it);
+            continue;
+        }
+        const std::uint64_t tag = static_cast<std::uint64_t>(step);
+        cache.insert(cache_key, value_of(tag));
+        reference.emplace_front(k, tag);
+        if (reference.size() > kCapacity) {
+            reference.pop_back();
+        }
+        ASSERT_EQ(cache.size(), reference.size());
+    }
+}
+
+TEST(PairCacheTest, QuantizedKeysShareRanges) {
+    EXPECT_EQ(ultrasound::pair_cache_model_key(0U, 4U, 1.2004F, 0.001F),
+              ultrasound::pair_cache_model_key(0U, 4U, 1.1996F, 0.001F));
+    EXPECT_NE(ultrasound::pair_cache_model_key(0U, 4U, 1.2004F, 0.0F),
+              ultrasound::pair_cache_model_key(0U, 4U, 1.1996F, 0.0F));
+    EXPECT_NE(ultrasound::pair_cache_model_key(0U, 4U, 1.2F, 0.0F), ultrasound::pair_cache_model_key(1U, 4U, 1.2F, 0.0F));
+    EXPECT_NE(ultrasound::pair_cache_model_key(0U, 4U, 1.2F, 0.0F), ultrasound::pair_cache_model_key(0U, 5U, 1.2F, 0.0F));
+    EXPECT_NEAR(ultrasound::pair_cache_range(1.2004F, 0.001F), 1.2, 1.0e-6);
+    EXPECT_EQ(ultrasound::pair_cache_range(1.2004F, 0.0F), static_cast<double>(1.2004F));
+}
+
+}  // namespace
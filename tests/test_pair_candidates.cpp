@@ -0,0 +1,115 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/ellipse_kernel.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/pair_candidates.hpp"
+
+namespace {
+
+using ultrasound::EllipseModel;
+using ultrasound::ModelOrigin;
+using ultrasound::ModelPair;
+using ultrasound::PairGenerationStats;
+using ultrasound::PairPruningRules;
+using ultrasound::PreparedEllipse;
+
+// The geometric quick-reject may only drop pairs the sampled collectors would find nothing in.
+TEST(PairCandidatesTest, QuickRejectNeverDropsReachablePairs) {
+    std::mt19937 rng(31U);
+    std::uniform_real_distribution<double> coord(-4.0, 4.0);
+    std::uniform_real_distribution<double> axis(0.05, 3.0);
+    std::uniform_real_distribution<double> angle(-3.2, 3.2);
+    constexpr double kLimit = 0.2;
+
+    std::vector<PreparedEllipse> models;
+    std::vector<ModelOrigin> origins;
+    for (int k = 0; k < 120; ++k) {
+        const double a = axis(rng);
+        const EllipseModel e{coord(rng), coord(rng), a, (k % 3 == 0) ? a : axis(rng), angle(rng)};
+        models.push_back(ultrasound::prepare_ellipse(e));
+        origins.push_back(ultrasound::make_model_origin(0U, static_cast<std::uint8_t>(k % 12), static_cast<std::uint8_t>((k + 1) % 12)));
+    }
+
+    std::vector<ModelPair> pairs;
+    PairGenerationStats stats;
+    ultrasound::generate_candidate_pairs(models, origins, PairPruningRules{}, kLimit, pairs, stats);
+    EXPECT_EQ(stats.emitted + stats.pruned, models.size() * (models.size() - 1U) / 2U);
+    EXPECT_GT(stats.pruned, 0U);
+    EXPECT_EQ(stats.emitted, pairs.size());
+
+    std::vector<std::vector<bool>> emitted(models.size(), std::vector<bool>(models.size(), false));
+    for (std::size_t k = 0; k < pairs.size(); ++k) {
+        ASSERT_LT(pairs[k].i, pairs[k].j);
+        if (k > 0U) {
+            EXPECT_TRUE(pairs[k - 1U].i < pairs[k].i || (pairs[k - 1U].i == pairs[k].i && pairs[k - 1U].j < pairs[k].j));
+        }
+        emitted[pairs[k].i][pairs[k].j] = true;
+    }
+
+    ultrasound::EllipseSampleBlock block;
+    std::array<double, ultrasound::kEllipseSamples + 1U> values{};
+    for (std::size_t i = 0; i + 1U < models.size(); ++i) {
+        ultrasound::sample_ellipse(models[i], block);
+        for (std::size_t j = i + 1U; j < models.size(); ++j) {
+            if (emitted[i][j]) {
+                continue;
+            }
+            ultrasound::ellipse_implicit_values(models[j], block.x.data(), block.y.data(), values.data(), values.size());
+            for (const double v : values) {
+                EXPECT_GT(std::fabs(v), kLimit) << "pair " << i << ", " << j;
+            }
+        }
+    }
+}
+
+TEST(PairCandidatesTest, GroupAndAdjacencyRules) {
+    // Four overlapping models, so only the rules can drop pairs.
+    const auto model = ultrasound::prepare_ellipse(EllipseModel{0.0, 0.0, 2.0, 1.5, 0.0});
+    const std::vector<PreparedEllipse> models(4U, model);
+    const std::vector<ModelOrigin> origins{
+        ultrasound::make_model_origin(0U, 0U, 1U),
+        ultrasound::make_model_origin(0U, 1U, 0U),
+        ultrasound::make_model_origin(0U, 3U, 3U),
+        ultrasound::make_model_origin(1U, 11U, 11U),
+    };
+
+    std::vector<ModelPair> pairs;
+    PairGenerationStats stats;
+    ultrasound::generate_candidate_pairs(models, origins, PairPruningRules{}, 0.2, pairs, stats);
+    EXPECT_EQ(pairs.size(), 6U);
+
+    PairPruningRules rules;
+    rules.skip_same_sensor_pair = true;
+    rules.skip_cross_group = true;
+    stats = PairGenerationStats{};
+    ultrasound::generate_candidate_pairs(models, origins, rules, 0.2, pairs, stats);
+    EXPECT_EQ(stats.same_sensor_pair, 1U);
+    EXPECT_EQ(stats.pruned, 3U);
+    ASSERT_EQ(pairs.size(), 2U);
+    EXPECT_EQ(pairs[0].i, 0U);
+    EXPECT_EQ(pairs[0].j, 2U);
+
+    // On the reference vehicle, 3 is two positions from 1 along the front bumper, while 0 and 11 sit at opposite
+    // ends of the left side and are not neighbours despite their ids.
+    const auto plan = ultrasound::default_geometry_plan();
+    rules = PairPruningRules{};
+    rules.max_sensor_gap = 2U;
+    rules.sensor_gaps = &plan->sensor_gaps;
+    rules.sensor_count = plan->sensor_x_m.size();
+    stats = PairGenerationStats{};
+    ultrasound::generate_candidate_pairs(models, origins, rules, 0.2, pairs, stats);
+    EXPECT_EQ(stats.pruned, 3U);
+    ASSERT_EQ(pairs.size(), 3U);
+    EXPECT_EQ(pairs[1].i, 0U);
+    EXPECT_EQ(pairs[1].j, 2U);
+    EXPECT_EQ(pairs[2].i, 1U);
+    EXPECT_EQ(pairs[2].j, 2U);
+}
+
+}  // namespace
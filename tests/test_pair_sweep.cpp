@@ -0,0 +1,141 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/ellipse_kernel.hpp"
+#include "ultrasound/geometry_plan.hpp"
+#include "ultrasound/intersection_lut.hpp"
+#include "ultrasound/pair_candidates.hpp"
+#include "ultrasound/pair_sweep.hpp"
+#include "ultrasound/processor_workspace.hpp"
+
+namespace {
+
+using ultrasound::EllipseSampleBlock;
+using ultrasound::GeometryPlan;
+using ultrasound::ModelPair;
+using ultrasound::PreparedEllipse;
+using Point = std::array<double, 2U>;
+
+// Sampled ellipse path parameters of the processor.
+constexpr double kTolerance = 0.08;
+constexpr double kBestLimit = 0.2;
+
+struct TwoPassStats {
+    std::size_t best_only{0U};
+    std::size_t best_cut{0U};
+};
+
+// The collectors as they were before the sweeps were fused: every pair's traverse roots, then every pair's
+// tolerance sweep, each evaluating b's implicit function on its own.
+std::vector<Point> two_pass(const GeometryPlan& plan,
+                            const std::vector<PreparedEllipse>& models,
+                            const std::vector<ModelPair>& pairs,
+                            TwoPassStats& stats) {
+    std::vector<Point> out;
+    EllipseSampleBlock samples;
+    std::vector<Point> roots;
+    for (const auto& pair : pairs) {
+        ultrasound::sample_ellipse(models[pair.i], samples);
+        roots.clear();
+        ultrasound::sample_ellipse_intersections(models[pair.i], samples, models[pair.j], roots);
+        for (const auto& p : roots) {
+            if (!ultrasound::is_inside_vehicle_contour(plan, p[0], p[1])) {
+                out.push_back(p);
+            }
+        }
+    }
+    std::array<double, ultrasound::kEllipseSamples + 1U> values{};
+    for (const auto& pair : pairs) {
+        ultrasound::sample_ellipse(models[pair.i], samples);
+        ultrasound::ellipse_implicit_values(models[pair.j], samples.x.data(), samples.y.data(), values.data(),
+                                            ultrasound::kEllipseSamples);
+        double best_err = std::numeric_limits<double>::max();
+        Point best{};
+        bool any_hit = false;
+        for (std::size_t s = 0; s < ultrasound::kEllipseSamples; ++s) {
+            const Point p{samples.x[s], samples.y[s]};
+            const double err = std::fabs(values[s]);
+            if (err < best_err) {
+                best_err = err;
+                best = p;
+            }
+            if (err <= kTolerance && !ultrasound::is_inside_vehicle_contour(plan, p[0], p[1])) {
+                out.push_back(p);
+                any_hit = true;
+            }
+        }
+        if (best_err > kBestLimit) {
+            ++stats.best_cut;
+        } else if (!ultrasound::is_inside_vehicle_contour(plan, best[0], best[1])) {
+            out.push_back(best);
+            stats.best_only += any_hit ? 0U : 1U;
+        }
+    }
+    return out;
+}
+
+// Random frames of signal-way ellipses on the reference vehicle; the fused collector, with every pair's roots
+// pushed before any pair's deferred hits as the processor does, must give the same points in the same order.
+TEST(PairSweepTest, FusedSweepMatchesTwoPassCollectors) {
+    const auto plan = ultrasound::default_geometry_plan();
+    std::mt19937 rng(17U);
+    std::uniform_real_distribution<double> range(0.2, 5.6);
+    std::uniform_int_distribution<int> way(0, 16);
+    std::uniform_int_distribution<int> group(0, 2);
+    std::uniform_int_distribution<int> count(2, 14);
+
+    TwoPassStats stats;
+    std::size_t deferred_points = 0U;
+    ultrasound::PairScratch scratch;
+    ultrasound::PairIntersections result;
+    for (int frame = 0; frame < 60; ++frame) {
+        std::vector<PreparedEllipse> models;
+        std::vector<ultrasound::ModelOrigin> origins;
+        const int n = count(rng);
+        while (static_cast<int>(models.size()) < n) {
+            const auto* pair = ultrasound::find_sensor_pair(plan->pairs, static_cast<std::uint8_t>(group(rng)),
+                                                            static_cast<std::uint8_t>(way(rng)));
+            if (pair == nullptr) {
+                continue;
+            }
+            if (const auto e = ultrasound::signal_way_ellipse(*pair, range(rng)); e.has_value()) {
+                models.push_back(ultrasound::prepare_ellipse(*e));
+                origins.push_back(ultrasound::make_model_origin(0U, pair->tx, pair->rx));
+            }
+        }
+        std::vector<ModelPair> pairs;
+        ultrasound::PairGenerationStats generated;
+        ultrasound::generate_candidate_pairs(models, origins, ultrasound::PairPruningRules{}, kBestLimit, pairs,
+                                             generated);
+
+        std::vector<Point> fused;
+        std::vector<Point> deferred;
+        for (const auto& pair : pairs) {
+            ultrasound::sample_ellipse(models[pair.i], scratch.samples);
+            result.clear();
+            ultrasound::collect_pair_fused(*plan, models[pair.i], scratch.samples, models[pair.j], scratch, kTolerance,
+                                           kBestLimit, result);
+            ASSERT_LE(result.deferred_begin, result.points.size());
+            const auto split = result.points.begin() + static_cast<std::ptrdiff_t>(result.deferred_begin);
+            fused.insert(fused.end(), result.points.begin(), split);
+            deferred.insert(deferred.end(), split, result.points.end());
+        }
+        deferred_points += deferred.size();
+        fused.insert(fused.end(), deferred.begin(), deferred.end());
+
+        EXPECT_EQ(fused, two_pass(*plan, models, pairs, stats)) << "frame " << frame;
+    }
+    // The frames exercise tolerance hits as well as both sides of the best-sample cut-off.
+    EXPECT_GT(deferred_points, 0U);
+    EXPECT_GT(stats.best_only, 0U);
+    EXPECT_GT(stats.best_cut, 0U);
+}
+
+}  // namespace
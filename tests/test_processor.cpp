@@ -1,20 +1,34 @@
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "ultrasound/processor.hpp"
 
+#include "random_frames.hpp"
+
 namespace {
 
 using ultrasound::ErrorCode;
 using ultrasound::FrameInput;
+using ultrasound::FrameOutput;
 using ultrasound::GroupFilter;
+using ultrasound::IntersectionSolver;
 using ultrasound::ProcessingMethod;
 using ultrasound::ProcessorConfig;
 using ultrasound::SignalWay;
 using ultrasound::UltrasoundProcessor;
 using ultrasound::VehicleState;
 
+static_assert(std::is_move_constructible_v<UltrasoundProcessor>);
+static_assert(std::is_move_assignable_v<UltrasoundProcessor>);
+
 void seed_states(UltrasoundProcessor& p) {
     VehicleState s0;
     s0.timestamp_us = 1000U;
@@ -194,4 +208,689 @@ TEST(ProcessorTest, DeterministicOutputForSameInputs) {
     EXPECT_EQ(o0->processed.clustered, o1->processed.clustered);
 }
 
+TEST(ProcessorTest, MonostaticTracingAndFovFollowSensorMounting) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::All;
+    UltrasoundProcessor p(cfg);
+    seed_states(p);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 2.0F, 0U, 0U});
+    in.signal_ways.push_back({1500U, 1.5F, 5U, 0U});  // unknown group: filtered before post-processing
+
+    ASSERT_TRUE(p.process_frame(in).is_ok());
+    const auto out = p.last_output();
+    ASSERT_TRUE(out.has_value());
+    ASSERT_EQ(out->signal_ways.size(), 1U);
+    ASSERT_EQ(out->processed.tracing.size(), 1U);
+    ASSERT_FALSE(out->processed.fov_intersections.empty());
+
+    const double mounting = 87.0 * (3.14159265358979323846 / 180.0);
+    EXPECT_NEAR(out->processed.tracing[0][0], 3.238 + 2.0 * std::cos(mounting), 1.0e-9);
+    EXPECT_NEAR(out->processed.tracing[0][1], 0.913 + 2.0 * std::sin(mounting), 1.0e-9);
+    EXPECT_NEAR(out->processed.fov_intersections[0][0], out->processed.tracing[0][0], 1.0e-9);
+    EXPECT_NEAR(out->processed.fov_intersections[0][1], out->processed.tracing[0][1], 1.0e-9);
+}
+
+TEST(ProcessorTest, AnalyticSolverAgreesWithSampledIntersections) {
+    ProcessorConfig sampled_cfg;
+    sampled_cfg.processing_method = ProcessingMethod::EllipseIntersection;
+    ProcessorConfig analytic_cfg = sampled_cfg;
+    analytic_cfg.intersection_solver = IntersectionSolver::Analytic;
+
+    UltrasoundProcessor sampled(sampled_cfg);
+    UltrasoundProcessor analytic(analytic_cfg);
+    seed_states(sampled);
+    seed_states(analytic);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 1.8F, 0U, 3U});
+    in.signal_ways.push_back({1500U, 1.9F, 0U, 4U});
+    in.signal_ways.push_back({1500U, 2.0F, 0U, 6U});
+    in.signal_ways.push_back({1500U, 2.2F, 0U, 9U});
+
+    ASSERT_TRUE(sampled.process_frame(in).is_ok());
+    ASSERT_TRUE(analytic.process_frame(in).is_ok());
+    const auto s = sampled.last_output();
+    const auto a = analytic.last_output();
+    ASSERT_TRUE(s.has_value());
+    ASSERT_TRUE(a.has_value());
+    ASSERT_FALSE(a->processed.ellipse_intersections.empty());
+
+    for (const auto& p : a->processed.ellipse_intersections) {
+        double best = 1.0e9;
+        for (const auto& q : s->processed.ellipse_intersections) {
+            best = std::min(best, std::hypot(p[0] - q[0], p[1] - q[1]));
+        }
+        EXPECT_LT(best, 0.1);
+    }
+}
+
+TEST(ProcessorTest, ReusedWorkspaceDoesNotLeakAcrossFrames) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::All;
+    cfg.strict_monotonic_timestamps = false;
+
+    FrameInput busy;
+    busy.timestamp_us = 1500U;
+    busy.signal_ways.push_back({1500U, 2.0F, 0U, 1U});
+    busy.signal_ways.push_back({1500U, 2.1F, 0U, 2U});
+    busy.signal_ways.push_back({1500U, 2.3F, 1U, 13U});
+    busy.signal_ways.push_back({1500U, 2.4F, 1U, 14U});
+    FrameInput quiet;
+    quiet.timestamp_us = 1600U;
+    quiet.signal_ways.push_back({1600U, 2.5F, 1U, 13U});
+
+    UltrasoundProcessor reused(cfg);
+    UltrasoundProcessor fresh(cfg);
+    seed_states(reused);
+    seed_states(fresh);
+
+    ASSERT_TRUE(reused.process_frame(busy).is_ok());
+    ASSERT_TRUE(reused.process_frame(quiet).is_ok());
+    ASSERT_TRUE(fresh.process_frame(quiet).is_ok());
+    const auto r = reused.last_output();
+    const auto f = fresh.last_output();
+    ASSERT_TRUE(r.has_value());
+    ASSERT_TRUE(f.has_value());
+    EXPECT_EQ(r->signal_ways.size(), f->signal_ways.size());
+    EXPECT_EQ(r->processed.tracing, f->processed.tracing);
+    EXPECT_EQ(r->processed.fov_intersections, f->processed.fov_intersections);
+    EXPECT_EQ(r->processed.ellipse_intersections, f->processed.ellipse_intersections);
+    EXPECT_EQ(r->processed.fused, f->processed.fused);
+    EXPECT_EQ(r->processed.clustered, f->processed.clustered);
+
+    ASSERT_TRUE(reused.process_frame(busy).is_ok());
+    ASSERT_TRUE(fresh.process_frame(busy).is_ok());
+    EXPECT_EQ(reused.last_output()->processed.clustered, fresh.last_output()->processed.clustered);
+}
+
+TEST(ProcessorTest, CallerOwnedOutputMatchesRetainedOutput) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::All;
+    UltrasoundProcessor retaining(cfg);
+    UltrasoundProcessor streaming(cfg);
+    seed_states(retaining);
+    seed_states(streaming);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 2.0F, 0U, 1U});
+    in.signal_ways.push_back({1500U, 2.1F, 0U, 2U});
+    in.signal_ways.push_back({1500U, 2.4F, 1U, 14U});
+
+    FrameOutput out;
+    ASSERT_TRUE(retaining.process_frame(in).is_ok());
+    ASSERT_TRUE(streaming.process_frame(in, out).is_ok());
+    EXPECT_FALSE(streaming.last_output().has_value());
+
+    const auto& retained = retaining.last_output();
+    ASSERT_TRUE(retained.has_value());
+    EXPECT_EQ(out.timestamp_us, retained->timestamp_us);
+    EXPECT_EQ(out.signal_ways.size(), retained->signal_ways.size());
+    EXPECT_EQ(out.processed.ellipse_intersections, retained->processed.ellipse_intersections);
+    EXPECT_EQ(out.processed.clustered, retained->processed.clustered);
+
+    // The retained output is updated in place, and a rejected frame leaves the caller's output alone.
+    const FrameOutput* retained_address = &*retained;
+    in.timestamp_us = 1600U;
+    ASSERT_TRUE(retaining.process_frame(in).is_ok());
+    EXPECT_EQ(&*retaining.last_output(), retained_address);
+    EXPECT_EQ(retaining.last_output()->timestamp_us, 1600U);
+
+    in.timestamp_us = 1400U;
+    EXPECT_EQ(streaming.process_frame(in, out).code, ErrorCode::OutOfOrderTimestamp);
+    EXPECT_EQ(out.timestamp_us, 1500U);
+}
+
+TEST(ProcessorTest, ConsumingOverloadMatchesCopyingOverload) {
+    ProcessorConfig cfg;
+    cfg.group_filter = GroupFilter::Front;
+    cfg.min_range_m = 0.5F;
+    cfg.processing_method = ProcessingMethod::All;
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 0.1F, 0U, 2U});  // filtered by min range
+    in.signal_ways.push_back({1500U, 2.0F, 0U, 1U});
+    in.signal_ways.push_back({1500U, 2.5F, 1U, 3U});  // filtered by group
+    in.signal_ways.push_back({1500U, 2.2F, 0U, 4U});
+    for (int i = 0; i < 4; ++i) {
+        ultrasound::StaticFeature sf;
+        sf.x_m = static_cast<float>(i);
+        sf.valid = (i % 2) == 1;
+        in.static_features.push_back(sf);
+    }
+    ultrasound::LineMark lm;
+    lm.x1_m = 1.0F;
+    lm.valid = true;
+    in.line_marks.push_back(lm);
+    in.line_marks.push_back(ultrasound::LineMark{});
+    in.grid_map.valid = true;
+    in.grid_map.rows = 2U;
+    in.grid_map.cols = 2U;
+    in.grid_map.occupancy = {0.1F, 0.2F, 0.3F, 0.4F};
+
+    UltrasoundProcessor copying(cfg);
+    UltrasoundProcessor consuming(cfg);
+    seed_states(copying);
+    seed_states(consuming);
+
+    FrameOutput copied;
+    FrameOutput moved;
+    ASSERT_TRUE(copying.process_frame(in, copied).is_ok());
+    FrameInput handed_over = in;
+    ASSERT_TRUE(consuming.process_frame(std::move(handed_over), moved).is_ok());
+
+    ASSERT_EQ(moved.signal_ways.size(), 2U);
+    EXPECT_EQ(moved.signal_ways[0].signal_way_id, 1U);
+    EXPECT_EQ(moved.signal_ways[1].signal_way_id, 4U);
+    ASSERT_EQ(moved.static_features.size(), 2U);
+    EXPECT_EQ(moved.static_features[0].x_m, 1.0F);
+    EXPECT_EQ(moved.static_features[1].x_m, 3.0F);
+    EXPECT_EQ(moved.line_marks.size(), 1U);
+    EXPECT_EQ(moved.grid_map.occupancy, in.grid_map.occupancy);
+    EXPECT_EQ(moved.processed.fused, copied.processed.fused);
+    EXPECT_EQ(moved.processed.clustered, copied.processed.clustered);
+    EXPECT_EQ(consuming.diagnostics().filtered_signal_ways, copying.diagnostics().filtered_signal_ways);
+
+    // A rejected frame is not consumed.
+    FrameInput stale = in;
+    EXPECT_FALSE(consuming.process_frame(std::move(stale)).is_ok());
+    EXPECT_EQ(stale.signal_ways.size(), in.signal_ways.size());
+    EXPECT_EQ(stale.grid_map.occupancy.size(), 4U);
+}
+
+TEST(ProcessorTest, ConfocalEllipsePairsAreSkipped) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::EllipseIntersection;
+    ProcessorConfig legacy_cfg = cfg;
+    legacy_cfg.skip_confocal_pairs = false;
+
+    UltrasoundProcessor p(cfg);
+    UltrasoundProcessor legacy(legacy_cfg);
+    seed_states(p);
+    seed_states(legacy);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 1.9F, 0U, 1U});  // tx 0 -> rx 1
+    in.signal_ways.push_back({1500U, 1.9F, 0U, 2U});  // tx 1 -> rx 0: identical ellipse
+    in.signal_ways.push_back({1500U, 2.1F, 0U, 2U});  // same foci, longer range: confocal
+    in.signal_ways.push_back({1500U, 2.0F, 0U, 6U});
+
+    ASSERT_TRUE(p.process_frame(in).is_ok());
+    ASSERT_TRUE(legacy.process_frame(in).is_ok());
+    // 4 models -> 6 pairs; the duplicate is merged (3 pairs) and the remaining confocal pair skipped (1).
+    EXPECT_EQ(p.diagnostics().skipped_ellipse_pairs, 4U);
+    EXPECT_EQ(legacy.diagnostics().skipped_ellipse_pairs, 0U);
+
+    // The identical pair floods the legacy path with tolerance hits along the whole ellipse.
+    const auto& kept = p.last_output()->processed.ellipse_intersections;
+    const auto& flooded = legacy.last_output()->processed.ellipse_intersections;
+    EXPECT_FALSE(kept.empty());
+    EXPECT_LT(kept.size(), flooded.size());
+}
+
+TEST(ProcessorTest, CandidatePairPruningIsCountedAndConfigurable) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::EllipseIntersection;
+    ProcessorConfig pruned_cfg = cfg;
+    pruned_cfg.prune_cross_group_pairs = true;
+
+    UltrasoundProcessor p(cfg);
+    UltrasoundProcessor pruned(pruned_cfg);
+    seed_states(p);
+    seed_states(pruned);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 1.2F, 0U, 0U});
+    in.signal_ways.push_back({1500U, 1.4F, 0U, 3U});
+    in.signal_ways.push_back({1500U, 1.3F, 0U, 6U});
+    in.signal_ways.push_back({1500U, 1.1F, 1U, 0U});
+    in.signal_ways.push_back({1500U, 1.5F, 1U, 6U});
+
+    ASSERT_TRUE(p.process_frame(in).is_ok());
+    ASSERT_TRUE(pruned.process_frame(in).is_ok());
+    // 5 models -> 10 pairs, none confocal.
+    const auto& d = p.diagnostics();
+    const auto& dp = pruned.diagnostics();
+    EXPECT_EQ(d.visited_model_pairs + d.pruned_model_pairs, 10U);
+    EXPECT_EQ(dp.visited_model_pairs + dp.pruned_model_pairs, 10U);
+    // The 6 front/rear pairs cannot meet and fall to the geometric quick-reject either way.
+    EXPECT_GE(d.pruned_model_pairs, 6U);
+    EXPECT_EQ(dp.visited_model_pairs, d.visited_model_pairs);
+    EXPECT_EQ(pruned.last_output()->processed.ellipse_intersections, p.last_output()->processed.ellipse_intersections);
+}
+
+TEST(ProcessorTest, AdaptiveSolverMatchesAnalyticSolver) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::EllipseIntersection;
+    cfg.intersection_solver = ultrasound::IntersectionSolver::Analytic;
+    ProcessorConfig adaptive_cfg = cfg;
+    adaptive_cfg.intersection_solver = ultrasound::IntersectionSolver::Adaptive;
+
+    UltrasoundProcessor analytic(cfg);
+    UltrasoundProcessor adaptive(adaptive_cfg);
+    seed_states(analytic);
+    seed_states(adaptive);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 1.2F, 0U, 0U});
+    in.signal_ways.push_back({1500U, 1.3F, 0U, 3U});
+    in.signal_ways.push_back({1500U, 1.6F, 0U, 6U});
+    in.signal_ways.push_back({1500U, 1.1F, 0U, 9U});
+
+    ASSERT_TRUE(analytic.process_frame(in).is_ok());
+    ASSERT_TRUE(adaptive.process_frame(in).is_ok());
+    // The solvers report a pair's roots starting from different parameters, so compare as sets.
+    auto expected = analytic.last_output()->processed.ellipse_intersections;
+    auto actual = adaptive.last_output()->processed.ellipse_intersections;
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_GT(actual.size(), 1U);
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_NEAR(actual[i][0], expected[i][0], 1.0e-6);
+        EXPECT_NEAR(actual[i][1], expected[i][1], 1.0e-6);
+    }
+}
+
+TEST(ProcessorTest, LookupSolverMatchesAnalyticSolver) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::EllipseIntersection;
+    cfg.intersection_solver = ultrasound::IntersectionSolver::Analytic;
+    ProcessorConfig lookup_cfg = cfg;
+    lookup_cfg.intersection_solver = ultrasound::IntersectionSolver::Lookup;
+
+    UltrasoundProcessor analytic(cfg);
+    UltrasoundProcessor lookup(lookup_cfg);
+    ASSERT_EQ(analytic.intersection_lut(), nullptr);
+    ASSERT_NE(lookup.intersection_lut(), nullptr);
+    // A matching table is shared rather than rebuilt.
+    UltrasoundProcessor sharing(lookup_cfg, lookup.geometry_plan(), lookup.intersection_lut());
+    EXPECT_EQ(sharing.intersection_lut().get(), lookup.intersection_lut().get());
+    seed_states(analytic);
+    seed_states(lookup);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 1.2F, 0U, 0U});
+    in.signal_ways.push_back({1500U, 1.3F, 0U, 3U});
+    in.signal_ways.push_back({1500U, 1.6F, 0U, 6U});
+    in.signal_ways.push_back({1500U, 1.1F, 0U, 9U});
+
+    ASSERT_TRUE(analytic.process_frame(in).is_ok());
+    ASSERT_TRUE(lookup.process_frame(in).is_ok());
+    EXPECT_GT(lookup.diagnostics().lut_lookups, 0U);
+    auto expected = analytic.last_output()->processed.ellipse_intersections;
+    auto actual = lookup.last_output()->processed.ellipse_intersections;
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_GT(actual.size(), 1U);
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_NEAR(actual[i][0], expected[i][0], 1.0e-3);
+        EXPECT_NEAR(actual[i][1], expected[i][1], 1.0e-3);
+    }
+}
+
+TEST(ProcessorTest, PairCacheReusesRepeatedPairsWithoutChangingResults) {
+    ProcessorConfig cfg;
+    cfg.reuse_unchanged_frames = false;
+    ProcessorConfig uncached_cfg = cfg;
+    uncached_cfg.pair_cache_capacity = 0U;
+    UltrasoundProcessor cached(cfg);
+    UltrasoundProcessor uncached(uncached_cfg);
+    seed_states(cached);
+    seed_states(uncached);
+
+    FrameInput in;
+    in.signal_ways.push_back({0U, 1.2F, 0U, 0U});
+    in.signal_ways.push_back({0U, 1.3F, 0U, 3U});
+    in.signal_ways.push_back({0U, 1.6F, 0U, 6U});
+    in.signal_ways.push_back({0U, 1.1F, 0U, 9U});
+    std::uint64_t first_misses = 0U;
+    for (std::uint64_t frame = 0; frame < 3U; ++frame) {
+        in.timestamp_us = 1500U + 100U * frame;
+        for (auto& sw : in.signal_ways) {
+            sw.timestamp_us = in.timestamp_us;
+        }
+        // The last frame moves one range: pairs with that signal way are recomputed, the rest still hit.
+        if (frame == 2U) {
+            in.signal_ways[3].distance_m = 1.15F;
+        }
+        ASSERT_TRUE(cached.process_frame(in).is_ok());
+        ASSERT_TRUE(uncached.process_frame(in).is_ok());
+        EXPECT_EQ(cached.last_output()->processed.ellipse_intersections,
+                  uncached.last_output()->processed.ellipse_intersections);
+        EXPECT_EQ(cached.last_output()->processed.clustered, uncached.last_output()->processed.clustered);
+        if (frame == 0U) {
+            first_misses = cached.diagnostics().pair_cache_misses;
+            EXPECT_GT(first_misses, 0U);
+            EXPECT_EQ(cached.diagnostics().pair_cache_hits, 0U);
+        }
+    }
+    const auto d = cached.diagnostics();
+    EXPECT_GE(d.pair_cache_hits, first_misses);
+    EXPECT_GT(d.pair_cache_misses, first_misses);
+    EXPECT_EQ(uncached.diagnostics().pair_cache_hits + uncached.diagnostics().pair_cache_misses, 0U);
+}
+
+TEST(ProcessorTest, PairCacheQuantizationSharesNearbyRanges) {
+    ProcessorConfig cfg;
+    cfg.processing_method = ProcessingMethod::EllipseIntersection;
+    cfg.pair_cache_quantization_m = 0.01F;
+    cfg.reuse_unchanged_frames = false;
+    UltrasoundProcessor p(cfg);
+    seed_states(p);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 1.201F, 0U, 0U});
+    in.signal_ways.push_back({1500U, 1.302F, 0U, 3U});
+    ASSERT_TRUE(p.process_frame(in).is_ok());
+    const auto first = p.last_output()->processed.ellipse_intersections;
+    in.timestamp_us = 1600U;
+    in.signal_ways[0] = {1600U, 1.198F, 0U, 0U};
+    in.signal_ways[1] = {1600U, 1.299F, 0U, 3U};
+    ASSERT_TRUE(p.process_frame(in).is_ok());
+    EXPECT_EQ(p.diagnostics().pair_cache_hits, p.diagnostics().pair_cache_misses);
+    EXPECT_GT(p.diagnostics().pair_cache_hits, 0U);
+    EXPECT_EQ(p.last_output()->processed.ellipse_intersections, first);
+}
+
+TEST(ProcessorTest, UnchangedFramesReusePreviousDetections) {
+    ProcessorConfig cfg;
+    ProcessorConfig fresh_cfg = cfg;
+    fresh_cfg.reuse_unchanged_frames = false;
+    UltrasoundProcessor reusing(cfg);
+    UltrasoundProcessor fresh(fresh_cfg);
+    seed_states(reusing);
+    seed_states(fresh);
+
+    FrameInput in;
+    in.signal_ways.push_back({0U, 1.2F, 0U, 0U});
+    in.signal_ways.push_back({0U, 1.3F, 0U, 3U});
+    in.signal_ways.push_back({0U, 9.0F, 0U, 6U});
+    in.signal_ways.push_back({0U, 1.1F, 1U, 9U});
+    FrameOutput out;
+    // Frame 1 repeats frame 0 (the out-of-range way is filtered either way), frame 2 reorders it, frame 3 repeats 2.
+    for (std::uint64_t frame = 0; frame < 4U; ++frame) {
+        in.timestamp_us = 1500U + 100U * frame;
+        if (frame == 2U) {
+            std::swap(in.signal_ways[0], in.signal_ways[1]);
+        }
+        ASSERT_TRUE(reusing.process_frame(in, out).is_ok());
+        ASSERT_TRUE(fresh.process_frame(in).is_ok());
+        const auto& expected = fresh.last_output()->processed;
+        EXPECT_EQ(out.timestamp_us, in.timestamp_us);
+        EXPECT_EQ(out.processed.tracing, expected.tracing);
+        EXPECT_EQ(out.processed.ellipse_intersections, expected.ellipse_intersections);
+        EXPECT_EQ(out.processed.fov_intersections, expected.fov_intersections);
+        EXPECT_EQ(out.processed.fused, expected.fused);
+        EXPECT_EQ(out.processed.clustered, expected.clustered);
+    }
+    EXPECT_EQ(reusing.diagnostics().reused_frames, 2U);
+    EXPECT_EQ(reusing.diagnostics().processed_frames, 4U);
+    EXPECT_EQ(fresh.diagnostics().reused_frames, 0U);
+}
+
+// Ranges moving within one quantization step change the tracing points (and, without a pair cache, every
+// model), so such frames are never reused, whether or not the cache is on.
+TEST(ProcessorTest, FrameReuseIgnoresPairCacheQuantization) {
+    for (const std::uint32_t capacity : {0U, 4096U}) {
+        ProcessorConfig cfg;
+        cfg.pair_cache_capacity = capacity;
+        cfg.pair_cache_quantization_m = 0.01F;
+        ProcessorConfig fresh_cfg = cfg;
+        fresh_cfg.reuse_unchanged_frames = false;
+        UltrasoundProcessor reusing(cfg);
+        UltrasoundProcessor fresh(fresh_cfg);
+        seed_states(reusing);
+        seed_states(fresh);
+
+        FrameInput in;
+        in.signal_ways.push_back({0U, 1.2F, 0U, 0U});
+        in.signal_ways.push_back({0U, 1.3F, 0U, 3U});
+        in.signal_ways.push_back({0U, 1.1F, 1U, 9U});
+        FrameOutput out;
+        for (std::uint64_t frame = 0; frame < 3U; ++frame) {
+            in.timestamp_us = 1500U + 100U * frame;
+            in.signal_ways[0].distance_m = 1.2F + 0.001F * static_cast<float>(frame);
+            ASSERT_TRUE(reusing.process_frame(in, out).is_ok());
+            ASSERT_TRUE(fresh.process_frame(in).is_ok());
+            const auto& expected = fresh.last_output()->processed;
+            EXPECT_EQ(out.processed.tracing, expected.tracing) << "capacity " << capacity;
+            EXPECT_EQ(out.processed.ellipse_intersections, expected.ellipse_intersections) << "capacity " << capacity;
+            EXPECT_EQ(out.processed.fov_intersections, expected.fov_intersections) << "capacity " << capacity;
+            EXPECT_EQ(out.processed.fused, expected.fused) << "capacity " << capacity;
+        }
+        EXPECT_EQ(reusing.diagnostics().reused_frames, 0U);
+    }
+}
+
+// Random frames with repeats, out-of-order and empty frames; the batch must match the serial path exactly,
+// counters included (pair-cache counters aside, as each batch thread has its own cache).
+TEST(ProcessorTest, BatchMatchesSerialProcessing) {
+    ultrasound::test::RandomFrameSpec spec;
+    spec.seed = 11U;
+    spec.frames = 120U;
+    spec.step_us = 7U;
+    spec.max_signal_ways = 24;
+    spec.repeat_every = 9U;
+    spec.repeat_phase = 3U;
+    spec.late_every = 17U;
+    spec.late_phase = 5U;
+    spec.late_by_us = 40U;
+    const auto frames = ultrasound::test::random_frames(spec);
+
+    for (const auto solver : {ultrasound::IntersectionSolver::Sampled, ultrasound::IntersectionSolver::Analytic}) {
+        ProcessorConfig cfg;
+        cfg.intersection_solver = solver;
+        cfg.worker_threads = 4U;
+        UltrasoundProcessor serial(cfg);
+        UltrasoundProcessor batch(cfg);
+        seed_states(serial);
+        seed_states(batch);
+
+        std::vector<ultrasound::FrameOutput> outputs;
+        std::vector<ultrasound::Status> statuses;
+        const auto batch_status = batch.process_frames(frames, outputs, statuses);
+        ASSERT_EQ(outputs.size(), frames.size());
+        bool any_failed = false;
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            ultrasound::FrameOutput expected;
+            const auto st = serial.process_frame(frames[i], expected);
+            ASSERT_EQ(statuses[i].is_ok(), st.is_ok()) << "frame " << i;
+            any_failed = any_failed || !st.is_ok();
+            if (!st.is_ok()) {
+                EXPECT_EQ(statuses[i].code, st.code);
+                continue;
+            }
+            EXPECT_EQ(outputs[i].timestamp_us, expected.timestamp_us);
+            EXPECT_EQ(outputs[i].processed.tracing, expected.processed.tracing) << "frame " << i;
+            EXPECT_EQ(outputs[i].processed.fov_intersections, expected.processed.fov_intersections) << "frame " << i;
+            EXPECT_EQ(outputs[i].processed.ellipse_intersections, expected.processed.ellipse_intersections)
+                << "frame " << i;
+            EXPECT_EQ(outputs[i].processed.clustered, expected.processed.clustered) << "frame " << i;
+        }
+        EXPECT_TRUE(any_failed);
+        EXPECT_FALSE(batch_status.is_ok());
+        const auto a = serial.diagnostics();
+        const auto b = batch.diagnostics();
+        EXPECT_EQ(b.processed_frames, a.processed_frames);
+        EXPECT_EQ(b.dropped_frames, a.dropped_frames);
+        EXPECT_EQ(b.filtered_signal_ways, a.filtered_signal_ways);
+        EXPECT_EQ(b.clustered_detections, a.clustered_detections);
+        EXPECT_EQ(b.visited_model_pairs, a.visited_model_pairs);
+        EXPECT_EQ(b.pruned_model_pairs, a.pruned_model_pairs);
+        EXPECT_EQ(b.reused_frames, a.reused_frames);
+        EXPECT_GT(b.reused_frames, 0U);
+        EXPECT_EQ(b.pair_cache_hits + b.pair_cache_misses, a.pair_cache_hits + a.pair_cache_misses);
+
+        // A serial frame after the batch continues from the batch's state.
+        FrameInput next = frames.back();
+        next.timestamp_us = 5000U;
+        ASSERT_TRUE(serial.process_frame(next).is_ok());
+        ASSERT_TRUE(batch.process_frame(next).is_ok());
+        EXPECT_EQ(batch.last_output()->processed.clustered, serial.last_output()->processed.clustered);
+        EXPECT_EQ(batch.diagnostics().reused_frames, serial.diagnostics().reused_frames);
+    }
+}
+
+// Splitting a frame's pairs across threads must reproduce the single-threaded detections and counters exactly.
+// Every third frame repeats the previous one, so parallel passes also mix cached and computed pairs.
+TEST(ProcessorTest, ParallelPairPassesMatchSerialPairs) {
+    ultrasound::test::RandomFrameSpec spec;
+    spec.seed = 23U;
+    spec.frames = 30U;
+    spec.step_us = 7U;
+    spec.min_signal_ways = 24;
+    spec.max_signal_ways = 24;
+    spec.repeat_every = 3U;
+    spec.repeat_phase = 2U;
+    const auto frames = ultrasound::test::random_frames(spec);
+
+    for (const auto solver : {ultrasound::IntersectionSolver::Sampled, ultrasound::IntersectionSolver::Analytic,
+                              ultrasound::IntersectionSolver::Adaptive, ultrasound::IntersectionSolver::Lookup}) {
+        ProcessorConfig cfg;
+        cfg.intersection_solver = solver;
+        cfg.reuse_unchanged_frames = false;
+        cfg.worker_threads = 4U;
+        cfg.parallel_pair_threshold = 0U;
+        UltrasoundProcessor serial(cfg);
+        cfg.parallel_pair_threshold = 4U;
+        UltrasoundProcessor parallel(cfg, serial.geometry_plan(), serial.intersection_lut());
+        seed_states(serial);
+        seed_states(parallel);
+
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            ultrasound::FrameOutput expected;
+            ultrasound::FrameOutput actual;
+            ASSERT_TRUE(serial.process_frame(frames[i], expected).is_ok());
+            ASSERT_TRUE(parallel.process_frame(frames[i], actual).is_ok());
+            EXPECT_EQ(actual.processed.fov_intersections, expected.processed.fov_intersections) << "frame " << i;
+            EXPECT_EQ(actual.processed.ellipse_intersections, expected.processed.ellipse_intersections) << "frame " << i;
+            EXPECT_EQ(actual.processed.fused, expected.processed.fused) << "frame " << i;
+            EXPECT_EQ(actual.processed.clustered, expected.processed.clustered) << "frame " << i;
+        }
+        const auto a = serial.diagnostics();
+        const auto b = parallel.diagnostics();
+        EXPECT_EQ(a.parallel_pair_passes, 0U);
+        EXPECT_GT(b.parallel_pair_passes, 0U);
+        EXPECT_EQ(b.visited_model_pairs, a.visited_model_pairs);
+        EXPECT_EQ(b.lut_lookups, a.lut_lookups);
+        EXPECT_EQ(b.lut_fallbacks, a.lut_fallbacks);
+        EXPECT_EQ(b.pair_cache_hits, a.pair_cache_hits);
+        EXPECT_EQ(b.pair_cache_misses, a.pair_cache_misses);
+        EXPECT_GT(b.pair_cache_hits, 0U);
+    }
+}
+
+TEST(ProcessorTest, OfferedVehicleStatesAreTakenInBeforeEachFrame) {
+    ProcessorConfig cfg;
+    cfg.vehicle_state_channel_capacity = 2U;
+    UltrasoundProcessor p(cfg);
+
+    VehicleState s;
+    s.timestamp_us = 1000U;
+    s.pose.x_m = 1.0F;
+    EXPECT_TRUE(p.offer_vehicle_state(s));
+    s.timestamp_us = 2000U;
+    s.pose.x_m = 3.0F;
+    EXPECT_TRUE(p.offer_vehicle_state(s));
+    s.timestamp_us = 3000U;
+    EXPECT_FALSE(p.offer_vehicle_state(s));
+    EXPECT_EQ(p.vehicle_state_overflows(), 1U);
+
+    FrameInput in;
+    in.timestamp_us = 1500U;
+    in.signal_ways.push_back({1500U, 1.2F, 0U, 1U});
+    FrameOutput out;
+    ASSERT_TRUE(p.process_frame(in, out).is_ok());
+    EXPECT_FLOAT_EQ(out.observation_pose.x_m, 2.0F);
+
+    // Out of order with the states already taken in: dropped when the next frame arrives.
+    s.timestamp_us = 1800U;
+    EXPECT_TRUE(p.offer_vehicle_state(s));
+    in.timestamp_us = 1600U;
+    ASSERT_TRUE(p.process_frame(in, out).is_ok());
+    EXPECT_FLOAT_EQ(out.observation_pose.x_m, 2.2F);
+    EXPECT_EQ(p.diagnostics().rejected_vehicle_states, 1U);
+}
+
+// Odometry offers states on its own thread while frames are processed. States lie on a line (y = -x,
+// yaw = x / 10), so any pose interpolated from consistent states stays on it, and poses never move backwards.
+TEST(ProcessorTest, VehicleStateChannelRunsConcurrentlyWithFrames) {
+    ProcessorConfig cfg;
+    cfg.vehicle_state_channel_capacity = 16U;
+    UltrasoundProcessor p(cfg);
+    constexpr std::uint64_t kStates = 20000U;
+    const auto state_at = [](std::uint64_t k) {
+        VehicleState s;
+        s.timestamp_us = 1000U + 10U * k;
+        s.pose.x_m = static_cast<float>(k) * 1.0e-4F;
+        s.pose.y_m = -s.pose.x_m;
+        s.pose.yaw_rad = s.pose.x_m * 0.1F;
+        return s;
+    };
+
+    std::atomic<bool> done{false};
+    std::uint64_t refused = 0U;
+    std::thread odometry([&] {
+        for (std::uint64_t k = 0; k < kStates; ++k) {
+            while (!p.offer_vehicle_state(state_at(k))) {
+                ++refused;
+                std::this_thread::yield();
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    FrameInput in;
+    in.signal_ways.push_back({0U, 1.2F, 0U, 1U});
+    FrameOutput out;
+    std::uint64_t frames = 0U;
+    std::uint64_t missing = 0U;
+    bool has_pose = false;
+    float last_x = 0.0F;
+    in.timestamp_us = 1000U;
+    while (!done.load(std::memory_order_acquire) || frames < 100U) {
+        in.timestamp_us += 7U;
+        ++frames;
+        const auto st = p.process_frame(in, out);
+        if (!st.is_ok()) {
+            ASSERT_EQ(st.code, ErrorCode::MissingVehicleState);
+            ASSERT_FALSE(has_pose) << "frame " << frames;
+            ++missing;
+            continue;
+        }
+        ASSERT_NEAR(out.observation_pose.y_m, -out.observation_pose.x_m, 1.0e-5F);
+        ASSERT_NEAR(out.observation_pose.yaw_rad, out.observation_pose.x_m * 0.1F, 1.0e-5F);
+        ASSERT_GE(out.observation_pose.x_m, last_x);
+        has_pose = true;
+        last_x = out.observation_pose.x_m;
+    }
+    odometry.join();
+
+    // Every state is in now; a frame inside the last few states gets the exact interpolated pose.
+    const VehicleState last = state_at(kStates - 1U);
+    in.timestamp_us = std::max(in.timestamp_us + 1U, last.timestamp_us - 15U);
+    ASSERT_TRUE(p.process_frame(in, out).is_ok());
+    const auto expected_x =
+        static_cast<float>(std::min(in.timestamp_us, last.timestamp_us) - 1000U) * 1.0e-5F;
+    EXPECT_NEAR(out.observation_pose.x_m, expected_x, 1.0e-5F);
+
+    const auto d = p.diagnostics();
+    EXPECT_EQ(p.vehicle_state_overflows(), refused);
+    EXPECT_EQ(d.rejected_vehicle_states, 0U);
+    EXPECT_EQ(d.missing_state_frames, missing);
+    EXPECT_EQ(d.processed_frames, frames + 1U - missing);
+}
+
 }  // namespace
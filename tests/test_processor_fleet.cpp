@@ -0,0 +1,129 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/processor.hpp"
+#include "ultrasound/processor_fleet.hpp"
+
+#include "random_frames.hpp"
+
+namespace {
+
+using ultrasound::FleetFrameResult;
+using ultrasound::FrameInput;
+using ultrasound::ProcessorConfig;
+using ultrasound::ProcessorFleet;
+using ultrasound::UltrasoundProcessor;
+using ultrasound::VehicleState;
+
+std::vector<VehicleState> stream_states(std::uint32_t stream) {
+    std::vector<VehicleState> states(2U);
+    states[0].timestamp_us = 1000U;
+    states[0].pose.x_m = static_cast<float>(stream);
+    states[1].timestamp_us = 3000U;
+    states[1].pose.x_m = static_cast<float>(stream) + 2.0F;
+    states[1].pose.yaw_rad = 0.3F;
+    return states;
+}
+
+std::vector<FrameInput> stream_frames(std::uint32_t stream) {
+    ultrasound::test::RandomFrameSpec spec;
+    spec.seed = 100U + stream;
+    spec.frames = 40U;
+    spec.step_us = 40U;
+    spec.max_signal_ways = 14;
+    spec.late_every = 13U;
+    spec.late_phase = 7U;
+    spec.late_by_us = 90U;
+    return ultrasound::test::random_frames(spec);
+}
+
+// Interleaved submissions across streams must give every stream exactly what its own processor would.
+TEST(ProcessorFleetTest, StreamsMatchStandaloneProcessors) {
+    constexpr std::uint32_t kStreams = 6U;
+    ProcessorConfig cfg;
+    cfg.worker_threads = 4U;
+    ProcessorFleet fleet(cfg);
+    std::vector<std::vector<FrameInput>> frames;
+    for (std::uint32_t s = 0; s < kStreams; ++s) {
+        ASSERT_TRUE(fleet.add_stream(s).is_ok());
+        for (const auto& state : stream_states(s)) {
+            ASSERT_TRUE(fleet.push_vehicle_state(s, state).is_ok());
+        }
+        frames.push_back(stream_frames(s));
+    }
+    for (std::size_t f = 0; f < frames[0].size(); ++f) {
+        for (std::uint32_t s = 0; s < kStreams; ++s) {
+            ASSERT_TRUE(fleet.submit_frame(s, frames[s][f]).is_ok());
+        }
+    }
+    fleet.wait_idle();
+
+    std::uint64_t total = 0U;
+    for (std::uint32_t s = 0; s < kStreams; ++s) {
+        UltrasoundProcessor reference(cfg);
+        for (const auto& state : stream_states(s)) {
+            ASSERT_TRUE(reference.push_vehicle_state(state).is_ok());
+        }
+        std::vector<FleetFrameResult> results;
+        ASSERT_TRUE(fleet.take_results(s, results).is_ok());
+        ASSERT_EQ(results.size(), frames[s].size());
+        for (std::size_t f = 0; f < frames[s].size(); ++f) {
+            ultrasound::FrameOutput expected;
+            const auto st = reference.process_frame(frames[s][f], expected);
+            EXPECT_EQ(results[f].timestamp_us, frames[s][f].timestamp_us);
+            ASSERT_EQ(results[f].status.code, st.code) << "stream " << s << " frame " << f;
+            if (st.is_ok()) {
+                EXPECT_EQ(results[f].output.processed.ellipse_intersections, expected.processed.ellipse_intersections);
+                EXPECT_EQ(results[f].output.processed.clustered, expected.processed.clustered);
+            }
+        }
+        EXPECT_EQ(fleet.processor(s)->diagnostics().processed_frames, reference.diagnostics().processed_frames);
+        EXPECT_EQ(fleet.processor(s)->geometry_plan().get(), fleet.geometry_plan().get());
+        total += frames[s].size();
+    }
+
+    const auto stats = fleet.stats();
+    ASSERT_EQ(stats.streams.size(), kStreams);
+    EXPECT_EQ(stats.processed_frames + stats.failed_frames, total);
+    EXPECT_GT(stats.failed_frames, 0U);
+    for (std::uint32_t s = 0; s < kStreams; ++s) {
+        EXPECT_EQ(stats.streams[s].stream_id, s);
+        EXPECT_EQ(stats.streams[s].processed_frames + stats.streams[s].failed_frames, frames[s].size());
+    }
+    EXPECT_GT(stats.frames_per_second, 0.0);
+
+    std::vector<FleetFrameResult> drained;
+    ASSERT_TRUE(fleet.take_results(0U, drained).is_ok());
+    EXPECT_TRUE(drained.empty());
+}
+
+TEST(ProcessorFleetTest, StreamsShareOneLookupTable) {
+    ProcessorConfig cfg;
+    cfg.intersection_solver = ultrasound::IntersectionSolver::Lookup;
+    cfg.lut_resolution = 8U;
+    cfg.worker_threads = 2U;
+    ProcessorFleet fleet(cfg);
+    ASSERT_NE(fleet.intersection_lut(), nullptr);
+    ASSERT_TRUE(fleet.add_stream(7U).is_ok());
+    ASSERT_TRUE(fleet.add_stream(9U).is_ok());
+    EXPECT_EQ(fleet.processor(7U)->intersection_lut().get(), fleet.intersection_lut().get());
+    EXPECT_EQ(fleet.processor(9U)->intersection_lut().get(), fleet.intersection_lut().get());
+}
+
+TEST(ProcessorFleetTest, RejectsUnknownStreamsAndStaleStates) {
+    ProcessorFleet fleet(ProcessorConfig{});
+    ASSERT_TRUE(fleet.add_stream(1U).is_ok());
+    EXPECT_FALSE(fleet.add_stream(1U).is_ok());
+    EXPECT_FALSE(fleet.submit_frame(2U, FrameInput{}).is_ok());
+    EXPECT_EQ(fleet.processor(2U), nullptr);
+
+    VehicleState state;
+    state.timestamp_us = 500U;
+    ASSERT_TRUE(fleet.push_vehicle_state(1U, state).is_ok());
+    EXPECT_FALSE(fleet.push_vehicle_state(1U, state).is_ok());
+}
+
+}  // namespace
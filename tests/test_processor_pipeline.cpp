@@ -0,0 +1,172 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/processor.hpp"
+#include "ultrasound/processor_pipeline.hpp"
+
+#include "random_frames.hpp"
+
+namespace {
+
+using ultrasound::FrameInput;
+using ultrasound::FrameOutput;
+using ultrasound::ProcessorConfig;
+using ultrasound::ProcessorPipeline;
+using ultrasound::UltrasoundProcessor;
+using ultrasound::VehicleState;
+
+struct Published {
+    std::uint64_t sequence{0U};
+    bool ok{false};
+    std::uint64_t timestamp_us{0U};
+    std::vector<std::array<double, 2U>> ellipse_intersections{};
+    std::vector<std::array<double, 2U>> clustered{};
+};
+
+VehicleState state_at(std::uint64_t t) {
+    VehicleState s;
+    s.timestamp_us = t;
+    s.pose.x_m = static_cast<float>(t) * 1.0e-4F;
+    s.pose.yaw_rad = static_cast<float>(t) * 1.0e-5F;
+    return s;
+}
+
+// Frames with repeats, out-of-order and empty frames, interleaved with vehicle states.
+std::vector<FrameInput> test_frames() {
+    ultrasound::test::RandomFrameSpec spec;
+    spec.seed = 31U;
+    spec.frames = 80U;
+    spec.step_us = 50U;
+    spec.repeat_every = 7U;
+    spec.repeat_phase = 2U;
+    spec.late_every = 19U;
+    spec.late_phase = 4U;
+    spec.late_by_us = 120U;
+    return ultrasound::test::random_frames(spec);
+}
+
+TEST(ProcessorPipelineTest, MatchesSerialProcessingInSequenceOrder) {
+    const auto frames = test_frames();
+    UltrasoundProcessor serial{ProcessorConfig{}};
+    UltrasoundProcessor pipelined{ProcessorConfig{}};
+    ASSERT_TRUE(serial.push_vehicle_state(state_at(1000U)).is_ok());
+
+    std::vector<Published> published;
+    {
+        ProcessorPipeline pipeline(
+            pipelined,
+            [&published](std::uint64_t sequence, const ultrasound::Status& status, const FrameOutput& output) {
+                Published p;
+                p.sequence = sequence;
+                p.ok = status.is_ok();
+                p.timestamp_us = output.timestamp_us;
+                p.ellipse_intersections = output.processed.ellipse_intersections;
+                p.clustered = output.processed.clustered;
+                published.push_back(std::move(p));
+            },
+            4U);
+        ASSERT_TRUE(pipeline.push_vehicle_state(state_at(1000U)).is_ok());
+        EXPECT_FALSE(pipeline.push_vehicle_state(state_at(1000U)).is_ok());
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            if (i % 10U == 5U) {
+                ASSERT_TRUE(pipeline.push_vehicle_state(state_at(frames[i].timestamp_us + 500U)).is_ok());
+            }
+            EXPECT_EQ(pipeline.submit(frames[i]), i);
+        }
+        pipeline.flush();
+        const auto stats = pipeline.stats();
+        EXPECT_EQ(stats.submitted_frames, frames.size());
+        EXPECT_EQ(stats.published_frames, frames.size());
+        EXPECT_EQ(stats.admit.queue_depth + stats.postprocess.queue_depth + stats.publish.queue_depth, 0U);
+        EXPECT_GT(stats.admit.max_queue_depth, 0U);
+        EXPECT_LE(stats.admit.max_queue_depth, 4U);
+    }
+
+    ASSERT_EQ(published.size(), frames.size());
+    bool any_failed = false;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        if (i % 10U == 5U) {
+            ASSERT_TRUE(serial.push_vehicle_state(state_at(frames[i].timestamp_us + 500U)).is_ok());
+        }
+        FrameOutput expected;
+        const auto st = serial.process_frame(frames[i], expected);
+        EXPECT_EQ(published[i].sequence, i);
+        ASSERT_EQ(published[i].ok, st.is_ok()) << "frame " << i;
+        any_failed = any_failed || !st.is_ok();
+        if (st.is_ok()) {
+            EXPECT_EQ(published[i].timestamp_us, expected.timestamp_us);
+            EXPECT_EQ(published[i].ellipse_intersections, expected.processed.ellipse_intersections) << "frame " << i;
+            EXPECT_EQ(published[i].clustered, expected.processed.clustered) << "frame " << i;
+        }
+    }
+    EXPECT_TRUE(any_failed);
+
+    // Stage counters are folded back on stop().
+    const auto a = serial.diagnostics();
+    const auto b = pipelined.diagnostics();
+    EXPECT_EQ(b.processed_frames, a.processed_frames);
+    EXPECT_EQ(b.dropped_frames, a.dropped_frames);
+    EXPECT_EQ(b.filtered_signal_ways, a.filtered_signal_ways);
+    EXPECT_EQ(b.clustered_detections, a.clustered_detections);
+    EXPECT_EQ(b.visited_model_pairs, a.visited_model_pairs);
+    EXPECT_EQ(b.reused_frames, a.reused_frames);
+    EXPECT_GT(b.reused_frames, 0U);
+    EXPECT_EQ(b.pair_cache_hits, a.pair_cache_hits);
+
+    // The processor continues serially from the pipeline's state.
+    FrameInput next = frames.back();
+    next.timestamp_us = 9000U;
+    ASSERT_TRUE(serial.process_frame(next).is_ok());
+    ASSERT_TRUE(pipelined.process_frame(next).is_ok());
+    EXPECT_EQ(pipelined.last_output()->processed.clustered, serial.last_output()->processed.clustered);
+}
+
+// The pipeline only checks states against its own; ones the processor already has newer states for are dropped
+// by the admit stage and counted like rejected channel states.
+TEST(ProcessorPipelineTest, CountsVehicleStatesTheProcessorRejects) {
+    UltrasoundProcessor processor{ProcessorConfig{}};
+    ASSERT_TRUE(processor.push_vehicle_state(state_at(5000U)).is_ok());
+    {
+        ProcessorPipeline pipeline(processor, nullptr);
+        ASSERT_TRUE(pipeline.push_vehicle_state(state_at(3000U)).is_ok());
+        ASSERT_TRUE(pipeline.push_vehicle_state(state_at(6000U)).is_ok());
+    }
+    EXPECT_EQ(processor.diagnostics().rejected_vehicle_states, 1U);
+}
+
+// A callback slower than ingestion backs the rings up; submissions stall but every frame is still delivered.
+TEST(ProcessorPipelineTest, SlowPublisherStallsUpstreamWithoutLosingFrames) {
+    UltrasoundProcessor processor{ProcessorConfig{}};
+    std::uint64_t next_expected = 0U;
+    bool in_order = true;
+    ProcessorPipeline pipeline(
+        processor,
+        [&](std::uint64_t sequence, const ultrasound::Status&, const FrameOutput&) {
+            in_order = in_order && sequence == next_expected;
+            ++next_expected;
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        },
+        2U);
+    ASSERT_TRUE(pipeline.push_vehicle_state(state_at(1000U)).is_ok());
+    for (std::uint64_t f = 0; f < 60U; ++f) {
+        FrameInput in;
+        in.timestamp_us = 1100U + f;
+        in.signal_ways.push_back({in.timestamp_us, 1.5F, 0U, 0U});
+        (void)pipeline.submit(std::move(in));
+    }
+    pipeline.stop();
+    EXPECT_EQ(next_expected, 60U);
+    EXPECT_TRUE(in_order);
+    const auto stats = pipeline.stats();
+    EXPECT_EQ(stats.published_frames, 60U);
+    EXPECT_GT(stats.submit_stalls + stats.admit.stalls + stats.postprocess.stalls, 0U);
+    EXPECT_EQ(processor.diagnostics().processed_frames, 60U);
+}
+
+}  // namespace
@@ -0,0 +1,64 @@
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/spatial_index.hpp"
+
+namespace {
+
+using Point = std::array<double, 2U>;
+
+void push_unique_linear(std::vector<Point>& detections, const Point& candidate, double min_sep) {
+    for (const auto& p : detections) {
+        const double dx = p[0] - candidate[0];
+        const double dy = p[1] - candidate[1];
+        if ((dx * dx + dy * dy) <= min_sep * min_sep) {
+            return;
+        }
+    }
+    detections.push_back(candidate);
+}
+
+TEST(SpatialIndexTest, UniqueGridMatchesLinearDedupeOrder) {
+    std::mt19937 rng(42U);
+    std::uniform_real_distribution<double> coord(-6.0, 6.0);
+    std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+
+    std::vector<Point> expected;
+    std::vector<Point> actual;
+    ultrasound::UniqueDetectionGrid grid;
+    grid.attach(actual);
+
+    Point last{0.0, 0.0};
+    for (int i = 0; i < 5000; ++i) {
+        // Mix fresh points with near-duplicates of the previous one to exercise the 3x3 neighbourhood.
+        const Point candidate = (i % 3 == 0) ? Point{coord(rng), coord(rng)}
+                                             : Point{last[0] + jitter(rng), last[1] + jitter(rng)};
+        last = candidate;
+        push_unique_linear(expected, candidate, 0.08);
+        const bool inserted = grid.push(candidate);
+        EXPECT_EQ(inserted, expected.size() == actual.size() && expected.back() == candidate);
+    }
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(SpatialIndexTest, AttachIndexesExistingDetections) {
+    std::vector<Point> detections{{1.0, 1.0}, {1.05, 1.0}, {-2.0, 0.5}};
+    ultrasound::UniqueDetectionGrid grid;
+    grid.attach(detections);
+
+    EXPECT_FALSE(grid.push({1.0, 1.079}));
+    EXPECT_FALSE(grid.push({-2.0, 0.58}));
+    EXPECT_TRUE(grid.push({-2.0, 0.581}));
+    EXPECT_TRUE(grid.push({3.0, 3.0}));
+    EXPECT_EQ(detections.size(), 5U);
+
+    std::vector<Point> other;
+    grid.attach(other);
+    EXPECT_TRUE(grid.push({1.0, 1.0}));
+    EXPECT_EQ(other.size(), 1U);
+}
+
+}  // namespace
@@ -0,0 +1,57 @@
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/spsc_ring.hpp"
+
+namespace {
+
+TEST(SpscRingTest, FillsToCapacityAndKeepsOrder) {
+    ultrasound::SpscRing<int> ring(5U);
+    ASSERT_EQ(ring.capacity(), 8U);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            EXPECT_TRUE(ring.try_push(round * 100 + i));
+        }
+        EXPECT_FALSE(ring.try_push(-1));
+        EXPECT_EQ(ring.size(), 8U);
+        int value = 0;
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(ring.try_pop(value));
+            EXPECT_EQ(value, round * 100 + i);
+        }
+        EXPECT_FALSE(ring.try_pop(value));
+        EXPECT_EQ(ring.size(), 0U);
+    }
+}
+
+// A small ring forces both sides through their wait paths many times.
+TEST(SpscRingTest, ConcurrentProducerAndConsumerSeeEveryItemInOrder) {
+    constexpr std::uint64_t kItems = 200000U;
+    ultrasound::SpscRing<std::uint64_t> ring(4U);
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < kItems; ++i) {
+            while (!ring.try_push(i)) {
+                ring.wait_for_space();
+            }
+        }
+    });
+    std::uint64_t expected = 0U;
+    bool in_order = true;
+    while (expected < kItems) {
+        std::uint64_t value = 0U;
+        if (!ring.try_pop(value)) {
+            ring.wait_for_item();
+            continue;
+        }
+        in_order = in_order && value == expected;
+        ++expected;
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(ring.size(), 0U);
+}
+
+}  // namespace
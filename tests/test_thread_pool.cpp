@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/thread_pool.hpp"
+
+namespace {
+
+TEST(ThreadPoolTest, VisitsEveryIndexOnceWithValidSlots) {
+    ultrasound::ThreadPool pool(3U);
+    ASSERT_EQ(pool.concurrency(), 4U);
+    for (std::size_t count : {0U, 1U, 7U, 1000U}) {
+        std::vector<std::atomic<int>> visits(count);
+        std::atomic<bool> slot_ok{true};
+        pool.parallel_for(count, [&](std::size_t i, std::size_t slot) {
+            visits[i].fetch_add(1);
+            if (slot >= pool.concurrency()) {
+                slot_ok = false;
+            }
+        });
+        for (const auto& v : visits) {
+            EXPECT_EQ(v.load(), 1);
+        }
+        EXPECT_TRUE(slot_ok.load());
+    }
+}
+
+TEST(ThreadPoolTest, ConcurrentCallersAreSerialized) {
+    ultrasound::ThreadPool pool(2U);
+    std::atomic<long> total{0};
+    const auto run = [&] {
+        for (int round = 0; round < 50; ++round) {
+            pool.parallel_for(16U, [&](std::size_t i, std::size_t) {
+                total.fetch_add(static_cast<long>(i));
+            });
+        }
+    };
+    std::thread a(run);
+    std::thread b(run);
+    a.join();
+    b.join();
+    EXPECT_EQ(total.load(), 2L * 50L * 120L);
+}
+
+TEST(ThreadPoolTest, BackgroundThreadCount) {
+    EXPECT_EQ(ultrasound::background_threads_for(1U), 0U);
+    EXPECT_EQ(ultrasound::background_threads_for(4U), 3U);
+    EXPECT_EQ(ultrasound::background_threads_for(0U) + 1U,
+              std::max<std::size_t>(std::thread::hardware_concurrency(), 1U));
+}
+
+}  // namespace
@@ -0,0 +1,58 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "ultrasound/work_stealing_pool.hpp"
+
+namespace {
+
+TEST(WorkStealingPoolTest, RunsEveryTaskIncludingNestedSubmissions) {
+    ultrasound::WorkStealingPool pool(3U);
+    ASSERT_EQ(pool.thread_count(), 3U);
+    std::atomic<int> runs{0};
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&] {
+                runs.fetch_add(1);
+                for (int k = 0; k < 10; ++k) {
+                    pool.submit([&] { runs.fetch_add(1); });
+                }
+            });
+        }
+        pool.wait_idle();
+        EXPECT_EQ(runs.load(), (round + 1) * 1100);
+    }
+}
+
+// Nested tasks land on the blocked thread's own deque, so only thieves can run them.
+TEST(WorkStealingPoolTest, IdleThreadsStealFromBusyThread) {
+    ultrasound::WorkStealingPool pool(4U);
+    std::atomic<int> runs{0};
+    pool.submit([&] {
+        for (int k = 0; k < 64; ++k) {
+            pool.submit([&] { runs.fetch_add(1); });
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (runs.load() < 64 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    pool.wait_idle();
+    EXPECT_EQ(runs.load(), 64);
+    EXPECT_GT(pool.steals(), 0U);
+}
+
+TEST(WorkStealingPoolTest, DestructorFinishesPendingTasks) {
+    std::atomic<int> runs{0};
+    {
+        ultrasound::WorkStealingPool pool(2U);
+        for (int i = 0; i < 200; ++i) {
+            pool.submit([&] { runs.fetch_add(1); });
+        }
+    }
+    EXPECT_EQ(runs.load(), 200);
+}
+
+}  // namespace